@@ -0,0 +1,186 @@
+#include "Archetype.h"
+
+#include <algorithm> /* std::max() */
+#include <new> /* operator new(), std::align_val_t */
+
+namespace ECS
+{
+	namespace
+	{
+		constexpr size_t ChunkAlignment{ 64 };
+
+		[[nodiscard]] constexpr size_t AlignUp(const size_t value, const size_t alignment)
+		{
+			return (value + alignment - 1) / alignment * alignment;
+		}
+	}
+
+	Archetype::Archetype(const EntitySignature& signature, const std::vector<ComponentType>& componentTypes, const std::vector<ComponentInfo>& componentInfos)
+		: m_Signature{ signature }
+		, m_ComponentTypes{ componentTypes }
+		, m_ComponentInfos{}
+		, m_ColumnOffsets{}
+		, m_Chunks{}
+		, m_ChunkCapacity{}
+		, m_Size{}
+		, m_AddEdges{}
+		, m_RemoveEdges{}
+	{
+		size_t rowSize{ sizeof(Entity) };
+
+		for (const ComponentType cType : m_ComponentTypes)
+		{
+			assert(componentInfos[cType].Alignment <= ChunkAlignment && "Archetype::Archetype() > Component alignment is too large for a chunk");
+
+			rowSize += componentInfos[cType].Size;
+		}
+
+		if (!m_ComponentTypes.empty())
+		{
+			m_ComponentInfos.resize(m_ComponentTypes.back() + 1);
+			m_ColumnOffsets.resize(m_ComponentTypes.back() + 1);
+		}
+
+		/* Start from the capacity without any padding and shrink it until the aligned columns fit in a chunk */
+		for (m_ChunkCapacity = std::max(ArchetypeChunkSize / rowSize, size_t(1)); m_ChunkCapacity > 1; --m_ChunkCapacity)
+		{
+			size_t offset{ sizeof(Entity) * m_ChunkCapacity };
+
+			for (const ComponentType cType : m_ComponentTypes)
+			{
+				offset = AlignUp(offset, componentInfos[cType].Alignment) + componentInfos[cType].Size * m_ChunkCapacity;
+			}
+
+			if (offset <= ArchetypeChunkSize)
+			{
+				break;
+			}
+		}
+
+		size_t offset{ sizeof(Entity) * m_ChunkCapacity };
+
+		for (const ComponentType cType : m_ComponentTypes)
+		{
+			offset = AlignUp(offset, componentInfos[cType].Alignment);
+
+			m_ComponentInfos[cType] = componentInfos[cType];
+			m_ColumnOffsets[cType] = offset;
+
+			offset += componentInfos[cType].Size * m_ChunkCapacity;
+		}
+
+		assert(offset <= ArchetypeChunkSize && "Archetype::Archetype() > A single row does not fit in a chunk");
+	}
+
+	Archetype::~Archetype()
+	{
+		for (size_t row{}; row < m_Size; ++row)
+		{
+			DestroyRow(row);
+		}
+
+		for (std::byte* const pChunk : m_Chunks)
+		{
+			operator delete(pChunk, std::align_val_t{ ChunkAlignment });
+		}
+	}
+
+	size_t Archetype::AddRow(const Entity entity)
+	{
+		if (m_Size == m_Chunks.size() * m_ChunkCapacity)
+		{
+			m_Chunks.push_back(static_cast<std::byte*>(operator new(ArchetypeChunkSize, std::align_val_t{ ChunkAlignment })));
+		}
+
+		const size_t row{ m_Size++ };
+
+		GetEntities(row / m_ChunkCapacity)[row % m_ChunkCapacity] = entity;
+
+		return row;
+	}
+
+	Entity Archetype::RemoveRow(const size_t row)
+	{
+		assert(row < m_Size);
+
+		DestroyRow(row);
+
+		const size_t lastRow{ --m_Size };
+		Entity movedEntity{ InvalidEntityID };
+
+		if (row != lastRow)
+		{
+			for (const ComponentType cType : m_ComponentTypes)
+			{
+				const ComponentInfo& info{ m_ComponentInfos[cType] };
+
+				info.MoveConstruct(GetComponent(row, cType), GetComponent(lastRow, cType));
+				info.Destroy(GetComponent(lastRow, cType));
+			}
+
+			movedEntity = GetEntity(lastRow);
+			GetEntities(row / m_ChunkCapacity)[row % m_ChunkCapacity] = movedEntity;
+		}
+
+		ReleaseEmptyChunk();
+
+		return movedEntity;
+	}
+
+	void Archetype::DiscardLastRow()
+	{
+		assert(m_Size > 0);
+
+		--m_Size;
+		ReleaseEmptyChunk();
+	}
+
+	void Archetype::MoveRowTo(const size_t row, Archetype& other, const size_t otherRow)
+	{
+		for (const ComponentType cType : m_ComponentTypes)
+		{
+			if (other.HasComponent(cType))
+			{
+				m_ComponentInfos[cType].MoveConstruct(other.GetComponent(otherRow, cType), GetComponent(row, cType));
+			}
+		}
+	}
+
+	Archetype*& Archetype::GetAddEdge(const ComponentType cType)
+	{
+		if (m_AddEdges.size() <= cType)
+		{
+			m_AddEdges.resize(cType + 1);
+		}
+
+		return m_AddEdges[cType];
+	}
+
+	Archetype*& Archetype::GetRemoveEdge(const ComponentType cType)
+	{
+		if (m_RemoveEdges.size() <= cType)
+		{
+			m_RemoveEdges.resize(cType + 1);
+		}
+
+		return m_RemoveEdges[cType];
+	}
+
+	void Archetype::DestroyRow(const size_t row)
+	{
+		for (const ComponentType cType : m_ComponentTypes)
+		{
+			m_ComponentInfos[cType].Destroy(GetComponent(row, cType));
+		}
+	}
+
+	/* Releases the last chunk as soon as it is empty */
+	void Archetype::ReleaseEmptyChunk()
+	{
+		if (m_Size == (m_Chunks.size() - 1) * m_ChunkCapacity)
+		{
+			operator delete(m_Chunks.back(), std::align_val_t{ ChunkAlignment });
+			m_Chunks.pop_back();
+		}
+	}
+}
\ No newline at end of file
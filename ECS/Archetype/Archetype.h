@@ -0,0 +1,94 @@
+#pragma once
+
+#include "../ECSConstants.h"
+#include "../ComponentIDGenerator/ComponentIDGenerator.h"
+#include "ComponentInfo.h"
+
+#include <assert.h> /* assert() */
+#include <cstddef> /* std::byte */
+#include <vector> /* std::vector */
+
+namespace ECS
+{
+	/* Stores every entity that has exactly the same set of components.
+	   Rows are packed into fixed-size chunks of ArchetypeChunkSize bytes, every chunk holds one column per component type
+	   (plus one for the entities), so a query over an archetype is a linear scan over its chunks */
+	class Archetype final
+	{
+	public:
+		/* componentTypes has to be sorted, componentInfos is indexed by ComponentType */
+		Archetype(const EntitySignature& signature, const std::vector<ComponentType>& componentTypes, const std::vector<ComponentInfo>& componentInfos);
+		~Archetype();
+
+		Archetype(const Archetype&) noexcept = delete;
+		Archetype(Archetype&&) noexcept = delete;
+		Archetype& operator=(const Archetype&) noexcept = delete;
+		Archetype& operator=(Archetype&&) noexcept = delete;
+
+		/* Adds a row for entity and returns it. The components of the row are not constructed, the caller has to construct every one of them */
+		size_t AddRow(const Entity entity);
+
+		/* Removes the last row without destroying its components, for a row added by AddRow() whose components could not be constructed */
+		void DiscardLastRow();
+
+		/* Destroys the components of row and moves the last row into it.
+		   Returns the entity that was moved into row, or InvalidEntityID if row was the last row */
+		Entity RemoveRow(const size_t row);
+
+		/* Moves every component this archetype shares with other from row into otherRow of other, which must not be constructed yet.
+		   The moved-from components stay in this archetype until the row is removed */
+		void MoveRowTo(const size_t row, Archetype& other, const size_t otherRow);
+
+		[[nodiscard]] bool HasComponent(const ComponentType cType) const { return cType < MaxComponentTypes && m_Signature.test(cType); }
+		[[nodiscard]] const EntitySignature& GetSignature() const { return m_Signature; }
+		[[nodiscard]] const std::vector<ComponentType>& GetComponentTypes() const { return m_ComponentTypes; }
+
+		[[nodiscard]] size_t Size() const { return m_Size; }
+		[[nodiscard]] size_t GetChunkCapacity() const { return m_ChunkCapacity; }
+		[[nodiscard]] size_t GetAmountOfChunks() const { return m_Chunks.size(); }
+		[[nodiscard]] size_t GetChunkSize(const size_t chunk) const
+		{
+			assert(chunk < m_Chunks.size());
+			return chunk + 1 < m_Chunks.size() ? m_ChunkCapacity : m_Size - chunk * m_ChunkCapacity;
+		}
+
+		[[nodiscard]] Entity GetEntity(const size_t row) const { return GetEntities(row / m_ChunkCapacity)[row % m_ChunkCapacity]; }
+		[[nodiscard]] Entity* GetEntities(const size_t chunk) const { return reinterpret_cast<Entity*>(m_Chunks[chunk]); }
+
+		[[nodiscard]] void* GetColumn(const size_t chunk, const ComponentType cType) const
+		{
+			assert(HasComponent(cType));
+			return m_Chunks[chunk] + m_ColumnOffsets[cType];
+		}
+		template<typename T>
+		[[nodiscard]] T* GetColumn(const size_t chunk) const
+		{
+			return static_cast<T*>(GetColumn(chunk, GenerateComponentID<T>()));
+		}
+
+		[[nodiscard]] void* GetComponent(const size_t row, const ComponentType cType) const
+		{
+			return static_cast<std::byte*>(GetColumn(row / m_ChunkCapacity, cType)) + (row % m_ChunkCapacity) * m_ComponentInfos[cType].Size;
+		}
+
+		/* Cached transitions to the archetype with one component type more or less, indexed by ComponentType */
+		[[nodiscard]] Archetype*& GetAddEdge(const ComponentType cType);
+		[[nodiscard]] Archetype*& GetRemoveEdge(const ComponentType cType);
+
+	private:
+		void DestroyRow(const size_t row);
+		void ReleaseEmptyChunk();
+
+		EntitySignature m_Signature;
+		std::vector<ComponentType> m_ComponentTypes;
+		std::vector<ComponentInfo> m_ComponentInfos; /* Indexed by ComponentType */
+		std::vector<size_t> m_ColumnOffsets; /* Indexed by ComponentType */
+
+		std::vector<std::byte*> m_Chunks;
+		size_t m_ChunkCapacity;
+		size_t m_Size;
+
+		std::vector<Archetype*> m_AddEdges;
+		std::vector<Archetype*> m_RemoveEdges;
+	};
+}
\ No newline at end of file
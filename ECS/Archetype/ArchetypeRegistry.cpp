@@ -0,0 +1,153 @@
+#include "ArchetypeRegistry.h"
+
+namespace ECS
+{
+	ArchetypeRegistry::ArchetypeRegistry()
+		: Locations{}
+		, RecycledEntities{}
+		, CurrentEntityCounter{}
+		, AmountOfEntities{}
+		, ComponentInfos{}
+		, Archetypes{}
+	{
+		Clear();
+	}
+
+	ArchetypeRegistry::~ArchetypeRegistry()
+	{
+		/* Archetypes destroy their components themselves */
+	}
+
+	ArchetypeRegistry::ArchetypeRegistry(ArchetypeRegistry&& other) noexcept
+		: Locations{ std::move(other.Locations) }
+		, RecycledEntities{ std::move(other.RecycledEntities) }
+		, CurrentEntityCounter{ std::move(other.CurrentEntityCounter) }
+		, AmountOfEntities{ std::move(other.AmountOfEntities) }
+		, ComponentInfos{ std::move(other.ComponentInfos) }
+		, Archetypes{ std::move(other.Archetypes) }
+	{
+		other.Clear();
+	}
+
+	ArchetypeRegistry& ArchetypeRegistry::operator=(ArchetypeRegistry&& other) noexcept
+	{
+		Locations = std::move(other.Locations);
+		RecycledEntities = std::move(other.RecycledEntities);
+		CurrentEntityCounter = std::move(other.CurrentEntityCounter);
+		AmountOfEntities = std::move(other.AmountOfEntities);
+		ComponentInfos = std::move(other.ComponentInfos);
+		Archetypes = std::move(other.Archetypes);
+
+		other.Clear();
+
+		return *this;
+	}
+
+	Entity ArchetypeRegistry::CreateEntity()
+	{
+		Entity entity{ InvalidEntityID };
+
+		if (!RecycledEntities.empty())
+		{
+			entity = RecycledEntities.back();
+			RecycledEntities.pop_back();
+		}
+		else
+		{
+			entity = CurrentEntityCounter++;
+			Locations.emplace_back();
+		}
+
+		assert(GetEntityIndex(entity) <= MaxEntities && "ArchetypeRegistry::CreateEntity() > The maximum amount of entities has been created. Consider increasing EntityIndexBits");
+
+		Archetype& root{ *Archetypes.front() };
+
+		Locations[GetEntityIndex(entity)] = EntityLocation{ entity, &root, root.AddRow(entity) };
+		++AmountOfEntities;
+
+		return entity;
+	}
+
+	bool ArchetypeRegistry::HasEntity(const Entity entity) const
+	{
+		const Entity index{ GetEntityIndex(entity) };
+
+		return index < Locations.size() && Locations[index].Handle == entity;
+	}
+
+	bool ArchetypeRegistry::ReleaseEntity(const Entity entity)
+	{
+		if (HasEntity(entity))
+		{
+			EntityLocation& location{ Locations[GetEntityIndex(entity)] };
+
+			RemoveRow(*location.pArchetype, location.Row);
+
+			location = EntityLocation{ InvalidEntityID, nullptr, 0 };
+			--AmountOfEntities;
+
+			RecycledEntities.push_back(GetRecycledEntityID(entity));
+
+			return true;
+		}
+
+		return false;
+	}
+
+	void ArchetypeRegistry::Clear()
+	{
+		Locations.clear();
+		RecycledEntities.clear();
+		CurrentEntityCounter = 0;
+		AmountOfEntities = 0;
+
+		Archetypes.clear();
+		Archetypes.emplace_back(new Archetype{ EntitySignature{}, {}, ComponentInfos });
+	}
+
+	void ArchetypeRegistry::MoveEntity(const Entity entity, Archetype& archetype, const size_t row)
+	{
+		EntityLocation& location{ Locations[GetEntityIndex(entity)] };
+
+		location.pArchetype->MoveRowTo(location.Row, archetype, row);
+
+		/* The moved-from components get destroyed together with the old row */
+		RemoveRow(*location.pArchetype, location.Row);
+
+		location.pArchetype = &archetype;
+		location.Row = row;
+	}
+
+	Archetype& ArchetypeRegistry::GetOrCreateArchetype(const EntitySignature& signature)
+	{
+		for (const std::unique_ptr<Archetype>& pArchetype : Archetypes)
+		{
+			if (pArchetype->GetSignature() == signature)
+			{
+				return *pArchetype;
+			}
+		}
+
+		std::vector<ComponentType> componentTypes{};
+
+		for (size_t cType{}; cType < ComponentInfos.size(); ++cType)
+		{
+			if (signature.test(cType))
+			{
+				componentTypes.push_back(static_cast<ComponentType>(cType));
+			}
+		}
+
+		return *Archetypes.emplace_back(new Archetype{ signature, componentTypes, ComponentInfos });
+	}
+
+	void ArchetypeRegistry::RemoveRow(Archetype& archetype, const size_t row)
+	{
+		const Entity movedEntity{ archetype.RemoveRow(row) };
+
+		if (movedEntity != InvalidEntityID)
+		{
+			Locations[GetEntityIndex(movedEntity)].Row = row;
+		}
+	}
+}
\ No newline at end of file
@@ -0,0 +1,194 @@
+#pragma once
+
+#include "../ECSConstants.h"
+#include "../ComponentIDGenerator/ComponentIDGenerator.h"
+#include "Archetype.h"
+#include "ArchetypeView.h"
+#include "ComponentInfo.h"
+
+#include <assert.h> /* assert() */
+#include <memory> /* std::unique_ptr */
+#include <new> /* placement new */
+#include <type_traits> /* std::remove_const_t */
+#include <utility> /* std::forward() */
+#include <vector> /* std::vector */
+
+namespace ECS
+{
+	/* Alternative to the Registry that groups entities by their full set of components into Archetypes, instead of keeping one
+	   ComponentArray per component type. Queries are linear scans over the chunks of the matching archetypes, at the cost of moving
+	   all of an entity's components whenever a component is added or removed. Pick the Registry that suits the workload.
+	   Only the basic entity and component operations are supported: there is no CreateEntities(), Reserve(), view filters or change ticks */
+	class ArchetypeRegistry final
+	{
+	public:
+		ArchetypeRegistry();
+		~ArchetypeRegistry();
+
+		ArchetypeRegistry(const ArchetypeRegistry&) noexcept = delete;
+		ArchetypeRegistry(ArchetypeRegistry&& other) noexcept;
+		ArchetypeRegistry& operator=(const ArchetypeRegistry&) noexcept = delete;
+		ArchetypeRegistry& operator=(ArchetypeRegistry&& other) noexcept;
+
+		template<typename ... Ts>
+		[[nodiscard]] ArchetypeView<Ts...> CreateView() const
+		{
+			EntitySignature signature{};
+			(signature.set(GenerateComponentID<Ts>()), ...);
+
+			std::vector<Archetype*> archetypes{};
+
+			for (const std::unique_ptr<Archetype>& pArchetype : Archetypes)
+			{
+				if ((pArchetype->GetSignature() & signature) == signature)
+				{
+					archetypes.push_back(pArchetype.get());
+				}
+			}
+
+			return ArchetypeView<Ts...>(std::move(archetypes));
+		}
+
+		template<typename T, typename ... Ts>
+		T& AddComponent(const Entity entity, Ts&& ... args)
+		{
+			assert(HasEntity(entity));
+			assert(!HasComponent<T>(entity) && "ArchetypeRegistry::AddComponent() > Entity already has this component");
+
+			const ComponentType cType{ GenerateComponentID<T>() };
+
+			RegisterComponentInfo<T>(cType);
+
+			EntityLocation& location{ Locations[GetEntityIndex(entity)] };
+
+			Archetype*& pEdge{ location.pArchetype->GetAddEdge(cType) };
+
+			if (!pEdge)
+			{
+				EntitySignature signature{ location.pArchetype->GetSignature() };
+				signature.set(cType);
+
+				pEdge = &GetOrCreateArchetype(signature);
+			}
+
+			Archetype& archetype{ *pEdge };
+
+			const size_t row{ archetype.AddRow(entity) };
+
+			/* The new component is constructed before anything is moved, so if its constructor throws the entity is left as it was */
+			T* pComponent{};
+
+			try
+			{
+				pComponent = new (archetype.GetComponent(row, cType)) T{ std::forward<Ts>(args)... };
+			}
+			catch (...)
+			{
+				archetype.DiscardLastRow();
+				throw;
+			}
+
+			MoveEntity(entity, archetype, row);
+
+			return *pComponent;
+		}
+
+		template<typename T>
+		void RemoveComponent(const Entity entity)
+		{
+			assert(HasEntity(entity));
+
+			if (!HasComponent<T>(entity))
+			{
+				return;
+			}
+
+			const ComponentType cType{ GenerateComponentID<T>() };
+
+			EntityLocation& location{ Locations[GetEntityIndex(entity)] };
+
+			Archetype*& pEdge{ location.pArchetype->GetRemoveEdge(cType) };
+
+			if (!pEdge)
+			{
+				EntitySignature signature{ location.pArchetype->GetSignature() };
+				signature.reset(cType);
+
+				pEdge = &GetOrCreateArchetype(signature);
+			}
+
+			MoveEntity(entity, *pEdge, pEdge->AddRow(entity));
+		}
+
+		template<typename T>
+		[[nodiscard]] bool HasComponent(const Entity entity) const
+		{
+			assert(HasEntity(entity));
+			return Locations[GetEntityIndex(entity)].pArchetype->HasComponent(GenerateComponentID<T>());
+		}
+
+		template<typename T>
+		[[nodiscard]] T& GetComponent(const Entity entity)
+		{
+			assert(HasComponent<T>(entity));
+
+			const EntityLocation& location{ Locations[GetEntityIndex(entity)] };
+
+			return *static_cast<T*>(location.pArchetype->GetComponent(location.Row, GenerateComponentID<T>()));
+		}
+		template<typename T>
+		[[nodiscard]] const T& GetComponent(const Entity entity) const
+		{
+			assert(HasComponent<T>(entity));
+
+			const EntityLocation& location{ Locations[GetEntityIndex(entity)] };
+
+			return *static_cast<const T*>(location.pArchetype->GetComponent(location.Row, GenerateComponentID<T>()));
+		}
+
+		[[nodiscard]] Entity CreateEntity();
+		[[nodiscard]] size_t GetAmountOfEntities() const { return AmountOfEntities; }
+		[[nodiscard]] size_t GetAmountOfArchetypes() const { return Archetypes.size(); }
+		[[nodiscard]] bool HasEntity(const Entity entity) const;
+		bool ReleaseEntity(const Entity entity);
+
+		void Clear();
+
+	private:
+		struct EntityLocation final
+		{
+			Entity Handle;
+			Archetype* pArchetype;
+			size_t Row;
+		};
+
+		template<typename T>
+		void RegisterComponentInfo(const ComponentType cType)
+		{
+			if (ComponentInfos.size() <= cType)
+			{
+				ComponentInfos.resize(cType + 1);
+			}
+
+			if (ComponentInfos[cType].Size == 0)
+			{
+				ComponentInfos[cType] = CreateComponentInfo<T>();
+			}
+		}
+
+		/* Moves entity and the components it shares with archetype over to row, which has been added to archetype for entity */
+		void MoveEntity(const Entity entity, Archetype& archetype, const size_t row);
+		[[nodiscard]] Archetype& GetOrCreateArchetype(const EntitySignature& signature);
+		void RemoveRow(Archetype& archetype, const size_t row);
+
+		// Entities
+		std::vector<EntityLocation> Locations; /* Indexed by entity index */
+		std::vector<Entity> RecycledEntities;
+		Entity CurrentEntityCounter;
+		size_t AmountOfEntities;
+
+		// Components
+		std::vector<ComponentInfo> ComponentInfos; /* Indexed by ComponentType */
+		std::vector<std::unique_ptr<Archetype>> Archetypes; /* The first archetype is the one without components */
+	};
+}
\ No newline at end of file
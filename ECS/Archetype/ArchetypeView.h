@@ -0,0 +1,64 @@
+#pragma once
+
+#include "../ECSConstants.h"
+#include "Archetype.h"
+
+#include <type_traits> /* std::remove_const_t */
+#include <utility> /* std::move() */
+#include <vector> /* std::vector */
+
+namespace ECS
+{
+	/* Every archetype that has all of Ts at the time the view was created. A const T only hands out const T&.
+	   Iteration is a linear scan over the chunks of those archetypes, entities and components must not be added or removed during it */
+	template<typename ... Ts>
+	class ArchetypeView final
+	{
+	public:
+		explicit ArchetypeView(std::vector<Archetype*>&& archetypes)
+			: m_Archetypes{ std::move(archetypes) }
+		{}
+
+		ArchetypeView(const ArchetypeView&) noexcept = delete;
+		ArchetypeView& operator=(const ArchetypeView&) noexcept = delete;
+
+		/* Function is called as function(Ts&...) */
+		template<typename Function>
+		void ForEach(Function&& function) const
+		{
+			for (const Archetype* const pArchetype : m_Archetypes)
+			{
+				for (size_t chunk{}; chunk < pArchetype->GetAmountOfChunks(); ++chunk)
+				{
+					ForEachInChunk(function, *pArchetype, chunk, pArchetype->template GetColumn<std::remove_const_t<Ts>>(chunk)...);
+				}
+			}
+		}
+
+		[[nodiscard]] size_t Size() const
+		{
+			size_t size{};
+
+			for (const Archetype* const pArchetype : m_Archetypes)
+			{
+				size += pArchetype->Size();
+			}
+
+			return size;
+		}
+
+	private:
+		template<typename Function, typename ... Columns>
+		__forceinline static void ForEachInChunk(Function& function, const Archetype& archetype, const size_t chunk, Columns* const ... pColumns)
+		{
+			const size_t chunkSize{ archetype.GetChunkSize(chunk) };
+
+			for (size_t i{}; i < chunkSize; ++i)
+			{
+				function(static_cast<Ts&>(pColumns[i])...);
+			}
+		}
+
+		std::vector<Archetype*> m_Archetypes;
+	};
+}
\ No newline at end of file
@@ -0,0 +1,37 @@
+#pragma once
+
+#include <new> /* placement new */
+#include <type_traits> /* std::is_move_constructible_v */
+#include <utility> /* std::move() */
+
+namespace ECS
+{
+	/* Everything an Archetype needs to know about a component type to store it in a type-erased column */
+	struct ComponentInfo final
+	{
+		size_t Size;
+		size_t Alignment;
+		void (*MoveConstruct)(void* pDestination, void* pSource);
+		void (*Destroy)(void* pComponent);
+	};
+
+	template<typename T>
+	[[nodiscard]] ComponentInfo CreateComponentInfo()
+	{
+		static_assert(std::is_move_constructible_v<T>, "CreateComponentInfo<T>() > T must be move constructible to live in an Archetype");
+
+		return ComponentInfo
+		{
+			sizeof(T),
+			alignof(T),
+			[](void* pDestination, void* pSource)->void
+			{
+				new (pDestination) T(std::move(*static_cast<T*>(pSource)));
+			},
+			[](void* pComponent)->void
+			{
+				static_cast<T*>(pComponent)->~T();
+			}
+		};
+	}
+}
\ No newline at end of file
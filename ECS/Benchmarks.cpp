@@ -1,6 +1,8 @@
 #include "ECSConstants.h"
 
+#include "Archetype/ArchetypeRegistry.h"
 #include "Registry/Registry.h"
+#include "Scheduler/SystemScheduler.h"
 
 #include "GOComponent/GOComponent.h"
 #include "GameObject/GameObject.h"
@@ -14,6 +16,7 @@
 
 #include "Benchmark/BenchmarkUtils.h"
 
+#include <cmath>
 #include <fstream>
 #include <iostream>
 #include <numeric>
@@ -26,6 +29,9 @@
 #define ENABLE_CUSTOMECS_BENCHMARKS
 #define BENCHMARK_CUSTOMECS_CREATION
 #define BENCHMARK_CUSTOMECS_UPDATE
+#define BENCHMARK_CUSTOMECS_SCHEDULED_UPDATE
+#define BENCHMARK_CUSTOMECS_ARCHETYPE_UPDATE
+#define BENCHMARK_CUSTOMECS_CACHED_GROUP_UPDATE
 
 //#define ENABLE_GAMEOBJECT_BENCHMARKS
 #define BENCHMARK_GAMEOBJECT_CREATION
@@ -39,6 +45,28 @@
 
 namespace
 {
+	__forceinline static void UpdateGravity(const GravityComponent& gravity, RigidBodyComponent& rigidBody)
+	{
+		rigidBody.Velocity.y += gravity.Gravity * rigidBody.Mass;
+	}
+
+	/* Steers towards a target that changes every second, touches none of the components the gravity system writes */
+	__forceinline static void UpdateAI(const TransformComponent& transform, AIComponent& ai)
+	{
+		ai.ThinkTimer -= 1.f / 60.f;
+
+		if (ai.ThinkTimer <= 0.f)
+		{
+			ai.ThinkTimer += 1.f;
+			ai.Target = Point2f{ ai.Target.y, ai.Target.x };
+		}
+
+		const Point2f toTarget{ ai.Target - transform.Position };
+		const float distance{ std::sqrt(toTarget.x * toTarget.x + toTarget.y * toTarget.y) };
+
+		ai.Direction = distance > 0.f ? toTarget * (1.f / distance) : Point2f{};
+	}
+
 	__forceinline static double GetAverage(const std::vector<double>& arr)
 	{
 		return std::accumulate(arr.cbegin(), arr.cend(), 0.0) / static_cast<double>(arr.size());
@@ -82,16 +110,11 @@ int RunBenchmarks(const int iterations, const size_t amountOfEntities)
 				registry.Clear();
 			});
 
-		ecsInitTimes = benchmarker.BenchmarkFunction(iterations, [&registry, amountOfEntities]()->void
-			{
-				for (size_t i{}; i < amountOfEntities; ++i)
-				{
-					Entity entity{ registry.CreateEntity() };
+		std::vector<Entity> entities(amountOfEntities);
 
-					registry.AddComponent<TransformComponent>(entity);
-					registry.AddComponent<RigidBodyComponent>(entity);
-					registry.AddComponent<GravityComponent>(entity);
-				}
+		ecsInitTimes = benchmarker.BenchmarkFunction(iterations, [&registry, &entities, amountOfEntities]()->void
+			{
+				registry.CreateEntities<TransformComponent, RigidBodyComponent, GravityComponent>(amountOfEntities, entities.begin());
 			});
 	}
 
@@ -105,25 +128,90 @@ int RunBenchmarks(const int iterations, const size_t amountOfEntities)
 		Benchmark::BenchmarkUtils benchmarker{};
 		ECS::Registry ecsRegistry{};
 
+		std::vector<Entity> entities(amountOfEntities);
+		ecsRegistry.CreateEntities<TransformComponent, RigidBodyComponent, GravityComponent>(amountOfEntities, entities.begin());
+
+		ecsUpdateTimes = benchmarker.BenchmarkFunction(iterations, [&ecsRegistry]()->void
+			{
+				auto gravityView = ecsRegistry.CreateView<const GravityComponent, RigidBodyComponent>();
+
+				gravityView.ForEach([](const auto& gravity, auto& rigidBody)->void
+					{
+						rigidBody.Velocity.y += gravity.Gravity * rigidBody.Mass;
+					});
+
+				auto physicsView = ecsRegistry.CreateView<const RigidBodyComponent, TransformComponent>();
+
+				physicsView.ForEach([](const auto& rigidBody, auto& transform)->void
+					{
+						transform.Position.x += rigidBody.Velocity.x;
+						transform.Position.y += rigidBody.Velocity.y;
+					});
+			});
+	}
+
+#endif // BENCHMARK_CUSTOMECS_UPDATE
+
+#ifdef BENCHMARK_CUSTOMECS_SCHEDULED_UPDATE
+
+	/* The gravity and AI systems share no written component, so the scheduler runs them at the same time */
+	std::vector<double> ecsSequentialSystemsTimes{};
+	std::vector<double> ecsScheduledSystemsTimes{};
+
+	{
+		Benchmark::BenchmarkUtils benchmarker{};
+		ECS::Registry ecsRegistry{};
+
+		std::vector<Entity> entities(amountOfEntities);
+		ecsRegistry.CreateEntities<TransformComponent, RigidBodyComponent, GravityComponent, AIComponent>(amountOfEntities, entities.begin());
+
+		ecsSequentialSystemsTimes = benchmarker.BenchmarkFunction(iterations, [&ecsRegistry]()->void
+			{
+				ecsRegistry.CreateView<const GravityComponent, RigidBodyComponent>().ForEach(&UpdateGravity);
+				ecsRegistry.CreateView<const TransformComponent, AIComponent>().ForEach(&UpdateAI);
+			});
+
+		ECS::SystemScheduler scheduler{ ecsRegistry };
+
+		scheduler.AddSystem<const GravityComponent, RigidBodyComponent>(&UpdateGravity);
+		scheduler.AddSystem<const TransformComponent, AIComponent>(&UpdateAI);
+
+		ecsScheduledSystemsTimes = benchmarker.BenchmarkFunction(iterations, [&scheduler]()->void
+			{
+				scheduler.Update();
+			});
+	}
+
+#endif // BENCHMARK_CUSTOMECS_SCHEDULED_UPDATE
+
+#ifdef BENCHMARK_CUSTOMECS_ARCHETYPE_UPDATE
+
+	/* The same update as BENCHMARK_CUSTOMECS_UPDATE, with the components stored per archetype instead of per type */
+	std::vector<double> ecsArchetypeUpdateTimes{};
+
+	{
+		Benchmark::BenchmarkUtils benchmarker{};
+		ECS::ArchetypeRegistry archetypeRegistry{};
+
 		for (size_t i{}; i < amountOfEntities; ++i)
 		{
-			Entity entity{ ecsRegistry.CreateEntity() };
+			const Entity entity{ archetypeRegistry.CreateEntity() };
 
-			ecsRegistry.AddComponent<TransformComponent>(entity);
-			ecsRegistry.AddComponent<RigidBodyComponent>(entity);
-			ecsRegistry.AddComponent<GravityComponent>(entity);
+			archetypeRegistry.AddComponent<TransformComponent>(entity);
+			archetypeRegistry.AddComponent<RigidBodyComponent>(entity);
+			archetypeRegistry.AddComponent<GravityComponent>(entity);
 		}
 
-		ecsUpdateTimes = benchmarker.BenchmarkFunction(iterations, [&ecsRegistry]()->void
+		ecsArchetypeUpdateTimes = benchmarker.BenchmarkFunction(iterations, [&archetypeRegistry]()->void
 			{
-				auto gravityView = ecsRegistry.CreateView<GravityComponent, RigidBodyComponent>();
+				auto gravityView = archetypeRegistry.CreateView<const GravityComponent, RigidBodyComponent>();
 
 				gravityView.ForEach([](const auto& gravity, auto& rigidBody)->void
 					{
 						rigidBody.Velocity.y += gravity.Gravity * rigidBody.Mass;
 					});
 
-				auto physicsView = ecsRegistry.CreateView<RigidBodyComponent, TransformComponent>();
+				auto physicsView = archetypeRegistry.CreateView<const RigidBodyComponent, TransformComponent>();
 
 				physicsView.ForEach([](const auto& rigidBody, auto& transform)->void
 					{
@@ -133,7 +221,57 @@ int RunBenchmarks(const int iterations, const size_t amountOfEntities)
 			});
 	}
 
-#endif // BENCHMARK_CUSTOMECS_UPDATE
+#endif // BENCHMARK_CUSTOMECS_ARCHETYPE_UPDATE
+
+#ifdef BENCHMARK_CUSTOMECS_CACHED_GROUP_UPDATE
+
+	/* A four component system that only matches one in thirty entities, while its smallest pool holds one in five.
+	   The View visits every entity of that pool and tests its signature, the CachedGroup only visits the matching ones */
+	std::vector<double> ecsFourComponentViewTimes{};
+	std::vector<double> ecsFourComponentCachedGroupTimes{};
+
+	{
+		Benchmark::BenchmarkUtils benchmarker{};
+		ECS::Registry ecsRegistry{};
+
+		for (size_t i{}; i < amountOfEntities; ++i)
+		{
+			const Entity entity{ ecsRegistry.CreateEntity<TransformComponent>() };
+
+			if (i % 2 == 0)
+			{
+				ecsRegistry.AddComponent<RigidBodyComponent>(entity);
+			}
+			if (i % 3 == 0)
+			{
+				ecsRegistry.AddComponent<GravityComponent>(entity);
+			}
+			if (i % 5 == 0)
+			{
+				ecsRegistry.AddComponent<AIComponent>(entity);
+			}
+		}
+
+		const auto updateFallingAI([](const GravityComponent& gravity, const RigidBodyComponent& rigidBody, const TransformComponent& transform, AIComponent& ai)->void
+			{
+				ai.Target.y += gravity.Gravity * rigidBody.Mass;
+				UpdateAI(transform, ai);
+			});
+
+		ecsFourComponentViewTimes = benchmarker.BenchmarkFunction(iterations, [&ecsRegistry, &updateFallingAI]()->void
+			{
+				ecsRegistry.CreateView<const GravityComponent, const RigidBodyComponent, const TransformComponent, AIComponent>().ForEach(updateFallingAI);
+			});
+
+		auto& group = ecsRegistry.CreateCachedGroup<const GravityComponent, const RigidBodyComponent, const TransformComponent, AIComponent>();
+
+		ecsFourComponentCachedGroupTimes = benchmarker.BenchmarkFunction(iterations, [&group, &updateFallingAI]()->void
+			{
+				group.ForEach(updateFallingAI);
+			});
+	}
+
+#endif // BENCHMARK_CUSTOMECS_CACHED_GROUP_UPDATE
 
 #endif // ENABLE_CUSTOMECS_BENCHMARKS
 
@@ -304,6 +442,46 @@ int RunBenchmarks(const int iterations, const size_t amountOfEntities)
 
 #endif // BENCHMARK_CUSTOMECS_UPDATE
 
+#ifdef BENCHMARK_CUSTOMECS_SCHEDULED_UPDATE
+
+	std::cout << "ECS Sequential Systems Average:\t" << GetAverage(ecsSequentialSystemsTimes) << " milliseconds\n";
+	std::cout << "ECS Scheduled Systems Average:\t" << GetAverage(ecsScheduledSystemsTimes) << " milliseconds\n\n";
+
+#ifdef WRITE_TIMES_TO_CSV_FILES
+
+	WriteTimesToCSVFile(R"(.\Benchmarks\CE_SEQUENTIAL_SYSTEMS_BM.csv)", ecsSequentialSystemsTimes);
+	WriteTimesToCSVFile(R"(.\Benchmarks\CE_SCHEDULED_SYSTEMS_BM.csv)", ecsScheduledSystemsTimes);
+
+#endif // WRITE_TIMES_TO_CSV_FILES
+
+#endif // BENCHMARK_CUSTOMECS_SCHEDULED_UPDATE
+
+#ifdef BENCHMARK_CUSTOMECS_ARCHETYPE_UPDATE
+
+	std::cout << "ECS Archetype Update Average:\t" << GetAverage(ecsArchetypeUpdateTimes) << " milliseconds\n\n";
+
+#ifdef WRITE_TIMES_TO_CSV_FILES
+
+	WriteTimesToCSVFile(R"(.\Benchmarks\CE_ARCHETYPE_UPDATE_BM.csv)", ecsArchetypeUpdateTimes);
+
+#endif // WRITE_TIMES_TO_CSV_FILES
+
+#endif // BENCHMARK_CUSTOMECS_ARCHETYPE_UPDATE
+
+#ifdef BENCHMARK_CUSTOMECS_CACHED_GROUP_UPDATE
+
+	std::cout << "ECS 4 Component View Average:\t" << GetAverage(ecsFourComponentViewTimes) << " milliseconds\n";
+	std::cout << "ECS 4 Component Cached Group Average:\t" << GetAverage(ecsFourComponentCachedGroupTimes) << " milliseconds\n\n";
+
+#ifdef WRITE_TIMES_TO_CSV_FILES
+
+	WriteTimesToCSVFile(R"(.\Benchmarks\CE_FOUR_COMPONENT_VIEW_BM.csv)", ecsFourComponentViewTimes);
+	WriteTimesToCSVFile(R"(.\Benchmarks\CE_FOUR_COMPONENT_CACHED_GROUP_BM.csv)", ecsFourComponentCachedGroupTimes);
+
+#endif // WRITE_TIMES_TO_CSV_FILES
+
+#endif // BENCHMARK_CUSTOMECS_CACHED_GROUP_UPDATE
+
 #endif // ENABLE_CUSTOMECS_BENCHMARKS
 
 
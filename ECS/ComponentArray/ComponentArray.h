@@ -2,7 +2,15 @@
 
 #include "../ECSConstants.h"
 #include "../SparseSet/DenseSet.h"
+#include "ComponentStorage.h"
 
+#include <algorithm> /* std::sort(), std::fill_n() */
+#include <assert.h> /* assert() */
+#include <memory_resource> /* std::pmr::memory_resource, std::pmr::vector */
+#include <type_traits> /* std::is_same_v */
+#include <numeric> /* std::iota() */
+#include <span> /* std::span */
+#include <utility> /* std::forward(), std::swap() */
 #include <vector> /* std::vector */
 
 namespace ECS
@@ -13,59 +21,309 @@ namespace ECS
 		virtual ~IComponentArray() = default;
 
 		virtual void Remove(const Entity entity) = 0;
+		virtual void Remove(const std::span<const Entity> entities) = 0;
 		virtual void RemoveAll() = 0;
+		virtual void ShrinkToFit() = 0;
+		virtual void SetCurrentTick(const Tick tick) = 0;
 	};
 
+	/* The components are kept in ComponentTraits<T>::StorageType, in the same order as the entities.
+	   Every slot also remembers the tick its component was added at and the tick it was last handed out mutably at */
 	template<typename T>
 	class ComponentArray final : public IComponentArray
 	{
 	public:
-		ComponentArray() = default;
+		using StorageType = typename ComponentTraits<T>::StorageType;
+		using Reference = typename StorageType::Reference;
+		using ConstReference = typename StorageType::ConstReference;
+
+		/* Every entity shares the component of a tag, so looking one up does not need its index */
+		static constexpr bool IsTag{ std::is_same_v<StorageType, TagComponentStorage<T>> };
+
+		/* The entities and the components are allocated from pResource */
+		explicit ComponentArray(std::pmr::memory_resource* const pResource = std::pmr::get_default_resource())
+			: m_Entities{ pResource }
+			, m_Components{ pResource }
+			, m_AddedTicks{ pResource }
+			, m_ModifiedTicks{ pResource }
+			, m_CurrentTick{}
+		{}
 
 		ComponentArray(const ComponentArray&) noexcept = delete;
 		ComponentArray(ComponentArray&&) noexcept = default;
 		ComponentArray& operator=(const ComponentArray&) noexcept = delete;
 		ComponentArray& operator=(ComponentArray&&) noexcept = default;
 
-		T& AddComponent(const Entity entity)
+		Reference AddComponent(const Entity entity)
 		{
-			m_Entities.Add(entity, static_cast<Entity>(m_Components.size()));
-			return m_Components.emplace_back(T{});
+			assert(!HasEntity(entity) && "ComponentArray::AddComponent() > Entity already has this component");
+
+			m_Entities.Add(entity, static_cast<Entity>(m_Components.Size()));
+			AddTicks();
+			return m_Components.Emplace();
 		}
 		template<typename ... Ts>
-		T& AddComponent(const Entity entity, Ts&& ... args)
+		Reference AddComponent(const Entity entity, Ts&& ... args)
 		{
-			m_Entities.Add(entity, static_cast<Entity>(m_Components.size()));
-			return m_Components.emplace_back(T{ std::forward<Ts>(args)... });
+			assert(!HasEntity(entity) && "ComponentArray::AddComponent() > Entity already has this component");
+
+			m_Entities.Add(entity, static_cast<Entity>(m_Components.Size()));
+			AddTicks();
+			return m_Components.Emplace(std::forward<Ts>(args)...);
 		}
 
+		/* Moves the last component into the freed slot so the pool stays densely packed */
 		virtual void Remove(const Entity entity) override
 		{
+			if (!m_Entities.Contains(entity))
+			{
+				return;
+			}
+
+			const size_t index{ m_Entities.GetSecond(entity) };
+
+			m_Components.Remove(index);
+			m_AddedTicks[index] = m_AddedTicks.back();
+			m_AddedTicks.pop_back();
+
+			if constexpr (!IsTag)
+			{
+				m_ModifiedTicks[index] = m_ModifiedTicks.back();
+				m_ModifiedTicks.pop_back();
+			}
+
 			m_Entities.Remove(entity);
 		}
 
+		/* Removes every entity of entities that has this component, a single virtual call for a whole batch */
+		virtual void Remove(const std::span<const Entity> entities) override
+		{
+			for (const Entity entity : entities)
+			{
+				Remove(entity);
+			}
+		}
+
 		virtual void RemoveAll() override
 		{
 			m_Entities.Clear();
-			m_Components.clear();
+			m_Components.Clear();
+			m_AddedTicks.clear();
+			m_ModifiedTicks.clear();
+		}
+
+		/* Components that are added or handed out mutably from now on are stamped with tick */
+		virtual void SetCurrentTick(const Tick tick) override
+		{
+			m_CurrentTick = tick;
 		}
 
+		/* Swaps two packed slots, both the entities and their components */
+		void SwapAt(const size_t first, const size_t second)
+		{
+			if (first != second)
+			{
+				m_Components.Swap(first, second);
+				std::swap(m_AddedTicks[first], m_AddedTicks[second]);
+
+				if constexpr (!IsTag)
+				{
+					std::swap(m_ModifiedTicks[first], m_ModifiedTicks[second]);
+				}
+
+				m_Entities.SwapAt(first, second);
+			}
+		}
+
+		/* Makes room for capacity components. The sparse pages of the entities are only allocated by ReserveIndices() */
+		void Reserve(const size_t capacity)
+		{
+			m_Entities.Reserve(capacity);
+			m_Components.Reserve(capacity);
+			m_AddedTicks.reserve(capacity);
+
+			if constexpr (!IsTag)
+			{
+				m_ModifiedTicks.reserve(capacity);
+			}
+		}
+
+		/* Allocates the sparse pages of the count entity indices starting at firstIndex, adding entities with those indices does not allocate them */
+		void ReserveIndices(const Entity firstIndex, const size_t count)
+		{
+			m_Entities.AllocatePages(firstIndex, count);
+		}
+
+		/* Releases the memory that is not needed for the current components */
+		virtual void ShrinkToFit() override
+		{
+			m_Entities.ShrinkToFit();
+			m_Components.ShrinkToFit();
+			m_AddedTicks.shrink_to_fit();
+			m_ModifiedTicks.shrink_to_fit();
+		}
+
+		/* Reorders the pool so that iterating it back to front, like Views and Groups do, visits the components in the order of
+		   compare(ConstReference lhs, ConstReference rhs) */
+		template<typename Compare>
+		void Sort(Compare compare)
+		{
+			std::vector<size_t> order(Size());
+			std::iota(order.begin(), order.end(), size_t(0));
+
+			std::sort(order.begin(), order.end(), [this, &compare](const size_t lhs, const size_t rhs)->bool
+				{
+					return compare(std::as_const(*this).GetComponentAt(rhs), std::as_const(*this).GetComponentAt(lhs));
+				});
+
+			/* order[i] is the slot whose component belongs in slot i, every cycle of the permutation is applied with swaps */
+			for (size_t i{}; i < order.size(); ++i)
+			{
+				size_t current{ i };
+
+				while (order[current] != i)
+				{
+					const size_t next{ order[current] };
+
+					SwapAt(current, next);
+					order[current] = current;
+					current = next;
+				}
+
+				order[current] = current;
+			}
+		}
+
+		/* Moves the entities this pool shares with other to the back of the pool, in the same order as they have in other.
+		   Iterating both pools then visits the shared entities in the same order */
+		template<typename U>
+		void SortAs(const ComponentArray<U>& other)
+		{
+			size_t position{ Size() };
+
+			for (size_t i{ other.Size() }; i > 0; --i)
+			{
+				const Entity entity{ other.GetEntities().GetFirstAt(i - 1) };
+
+				if (HasEntity(entity))
+				{
+					SwapAt(GetIndex(entity), --position);
+				}
+			}
+		}
+
+		[[nodiscard]] size_t Size() const { return m_Components.Size(); }
+		/* The capacity of the storage, tags are not stored so only the room for their entities counts */
+		[[nodiscard]] size_t Capacity() const
+		{
+			if constexpr (IsTag)
+			{
+				return m_Entities.Capacity();
+			}
+			else
+			{
+				return m_Components.Capacity();
+			}
+		}
+		[[nodiscard]] const DenseSet<Entity>& GetEntities() const { return m_Entities; }
+		[[nodiscard]] size_t GetIndex(const Entity entity) const { return m_Entities.GetSecond(entity); }
+
 		[[nodiscard]] bool HasEntity(const Entity entity) const
 		{
 			return m_Entities.Contains(entity);
 		}
 
-		[[nodiscard]] T& GetComponent(const Entity entity)
+		[[nodiscard]] Reference GetComponent(const Entity entity)
+		{
+			if constexpr (IsTag)
+			{
+				assert(HasEntity(entity));
+				return m_Components[0];
+			}
+			else
+			{
+				return m_Components[m_Entities.GetSecond(entity)];
+			}
+		}
+		[[nodiscard]] ConstReference GetComponent(const Entity entity) const
+		{
+			if constexpr (IsTag)
+			{
+				assert(HasEntity(entity));
+				return m_Components[0];
+			}
+			else
+			{
+				return m_Components[m_Entities.GetSecond(entity)];
+			}
+		}
+
+		[[nodiscard]] Reference GetComponentAt(const size_t index) { return m_Components[index]; }
+		[[nodiscard]] ConstReference GetComponentAt(const size_t index) const { return m_Components[index]; }
+
+		/* Every component of the pool as one contiguous range, only available for storage that keeps whole components */
+		[[nodiscard]] auto GetComponents() { return m_Components.GetSpan(); }
+		[[nodiscard]] auto GetComponents() const { return m_Components.GetSpan(); }
+
+		[[nodiscard]] StorageType& GetStorage() { return m_Components; }
+		[[nodiscard]] const StorageType& GetStorage() const { return m_Components; }
+
+		/* Stamps count slots starting at index with the current tick. Getting a component does not do this on its own,
+		   whoever hands it out for writing does, e.g. Registry::GetComponent() and every View element that is not const.
+		   A tag has no state to modify, so it keeps the tick it was added at */
+		void MarkModifiedAt(const size_t index, const size_t count = 1)
 		{
-			return m_Components[m_Entities.GetSecond(entity)];
+			if constexpr (!IsTag)
+			{
+				assert(index + count <= m_ModifiedTicks.size());
+				std::fill_n(m_ModifiedTicks.begin() + index, count, m_CurrentTick);
+			}
 		}
-		[[nodiscard]] const T& GetComponent(const Entity entity) const
+		/* GetComponent() for writing, stamps the component with a single sparse lookup for both */
+		[[nodiscard]] Reference ModifyComponent(const Entity entity)
 		{
-			return m_Components[m_Entities.GetSecond(entity)];
+			if constexpr (IsTag)
+			{
+				return GetComponent(entity);
+			}
+			else
+			{
+				const size_t index{ m_Entities.GetSecond(entity) };
+
+				m_ModifiedTicks[index] = m_CurrentTick;
+				return m_Components[index];
+			}
+		}
+
+		[[nodiscard]] Tick GetCurrentTick() const { return m_CurrentTick; }
+		[[nodiscard]] Tick GetAddedTickAt(const size_t index) const { return m_AddedTicks[index]; }
+		[[nodiscard]] Tick GetModifiedTickAt(const size_t index) const
+		{
+			if constexpr (IsTag)
+			{
+				return m_AddedTicks[index];
+			}
+			else
+			{
+				return m_ModifiedTicks[index];
+			}
 		}
 
 	private:
+		void AddTicks()
+		{
+			m_AddedTicks.push_back(m_CurrentTick);
+
+			if constexpr (!IsTag)
+			{
+				m_ModifiedTicks.push_back(m_CurrentTick);
+			}
+		}
+
 		DenseSet<Entity> m_Entities;
-		std::vector<T> m_Components;
+		StorageType m_Components;
+		std::pmr::vector<Tick> m_AddedTicks; /* Kept apart from the modified ticks, so stamping and filtering only touch the ticks they need */
+		std::pmr::vector<Tick> m_ModifiedTicks; /* Stays empty for tags, which are never modified */
+		Tick m_CurrentTick;
 	};
 }
\ No newline at end of file
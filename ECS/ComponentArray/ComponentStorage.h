@@ -0,0 +1,104 @@
+#pragma once
+
+#include "../ECSConstants.h"
+#include "TagComponentStorage.h"
+
+#include <assert.h> /* assert() */
+#include <memory_resource> /* std::pmr::memory_resource, std::pmr::vector */
+#include <span> /* std::span */
+#include <tuple> /* std::tuple, std::forward_as_tuple(), std::apply() */
+#include <type_traits> /* std::conditional_t, std::is_empty_v */
+#include <utility> /* std::forward(), std::move(), std::swap() */
+
+namespace ECS
+{
+	/* Converts to T{ args... }. The conversion returns a prvalue, so a container constructing its element from this
+	   initialises the element itself instead of moving a temporary into it */
+	template<typename T, typename ... Ts>
+	struct BraceInitialiser final
+	{
+		std::tuple<Ts&&...> Args;
+
+		operator T() &&
+		{
+			return std::apply([](auto&& ... args)->T { return T{ std::forward<decltype(args)>(args)... }; }, std::move(Args));
+		}
+	};
+
+	/* The default storage of a ComponentArray, every component is stored as a whole next to the previous one */
+	template<typename T>
+	class ComponentStorage final
+	{
+	public:
+		using Reference = T&;
+		using ConstReference = const T&;
+
+		explicit ComponentStorage(std::pmr::memory_resource* const pResource = std::pmr::get_default_resource())
+			: m_Components{ pResource }
+		{}
+
+		/* Initialises the component in place as T{ args... } like the other storages do, so aggregates get brace elision and narrowing is rejected */
+		template<typename ... Ts>
+		Reference Emplace(Ts&& ... args)
+		{
+			return m_Components.emplace_back(BraceInitialiser<T, Ts...>{ std::forward_as_tuple(std::forward<Ts>(args)...) });
+		}
+
+		/* Moves the last component into index and shrinks the storage by one */
+		void Remove(const size_t index)
+		{
+			assert(index < m_Components.size());
+
+			if (index != m_Components.size() - 1)
+			{
+				m_Components[index] = std::move(m_Components.back());
+			}
+
+			m_Components.pop_back();
+		}
+
+		void Swap(const size_t first, const size_t second)
+		{
+			using std::swap;
+			swap(m_Components[first], m_Components[second]);
+		}
+
+		void Clear() { m_Components.clear(); }
+		void Reserve(const size_t capacity) { m_Components.reserve(capacity); }
+		void ShrinkToFit() { m_Components.shrink_to_fit(); }
+		[[nodiscard]] size_t Size() const { return m_Components.size(); }
+		[[nodiscard]] size_t Capacity() const { return m_Components.capacity(); }
+
+		[[nodiscard]] Reference operator[](const size_t index) { return m_Components[index]; }
+		[[nodiscard]] ConstReference operator[](const size_t index) const { return m_Components[index]; }
+
+		[[nodiscard]] std::span<T> GetSpan() { return m_Components; }
+		[[nodiscard]] std::span<const T> GetSpan() const { return m_Components; }
+
+	private:
+		std::pmr::vector<T> m_Components;
+	};
+
+	/* Specialise this for a component type to change how its ComponentArray stores it, see SoAComponentStorage and PagedComponentStorage.
+	   Empty types are tags and are stored without any memory per component */
+	template<typename T>
+	struct ComponentTraits
+	{
+		using StorageType = std::conditional_t<std::is_empty_v<T>, TagComponentStorage<T>, ComponentStorage<T>>;
+	};
+
+	template<typename T>
+	struct ComponentReferenceType
+	{
+		using Type = typename ComponentTraits<T>::StorageType::Reference;
+	};
+	template<typename T>
+	struct ComponentReferenceType<const T>
+	{
+		using Type = typename ComponentTraits<T>::StorageType::ConstReference;
+	};
+
+	/* What a ComponentArray hands out for a T, T& for the default storage. A const T gives the const version */
+	template<typename T>
+	using ComponentReference = typename ComponentReferenceType<T>::Type;
+}
@@ -0,0 +1,151 @@
+#pragma once
+
+#include "../ECSConstants.h"
+#include "../Utils/PageList.h"
+
+#include <assert.h> /* assert() */
+#include <memory> /* std::destroy_at() */
+#include <memory_resource> /* std::pmr::memory_resource */
+#include <new> /* placement new */
+#include <utility> /* std::move(), std::swap() */
+
+namespace ECS
+{
+	/* Stores the components in fixed-size pages of PageSize components instead of one growing array.
+	   Adding a component never moves the existing ones, so references stay valid while the pool grows.
+	   Removing a component still moves the last component into the freed slot, and a Group or a sort can reorder the pool,
+	   so a reference is stable until a component of the pool is removed or the pool is reordered.
+	   Opt in per component type:
+
+	   template<>
+	   struct ECS::ComponentTraits<TransformComponent>
+	   {
+		   using StorageType = ECS::PagedComponentStorage<TransformComponent>;
+	   }; */
+	template<typename T, size_t PageSize = ComponentPageSize>
+	class PagedComponentStorage final
+	{
+		static_assert(PageSize > 0, "PagedComponentStorage needs room for at least one component per page");
+
+	public:
+		using Reference = T&;
+		using ConstReference = const T&;
+
+		explicit PagedComponentStorage(std::pmr::memory_resource* const pResource = std::pmr::get_default_resource())
+			: m_Pages{ pResource }
+			, m_Size{}
+		{}
+		~PagedComponentStorage()
+		{
+			Clear();
+		}
+
+		PagedComponentStorage(const PagedComponentStorage&) noexcept = delete;
+		PagedComponentStorage(PagedComponentStorage&& other) noexcept
+			: m_Pages{ std::move(other.m_Pages) }
+			, m_Size{ other.m_Size }
+		{
+			other.m_Size = 0;
+		}
+		PagedComponentStorage& operator=(const PagedComponentStorage&) noexcept = delete;
+		PagedComponentStorage& operator=(PagedComponentStorage&& other) noexcept
+		{
+			if (this == &other)
+			{
+				return *this;
+			}
+
+			Clear();
+
+			if (m_Pages.TakePages(other.m_Pages))
+			{
+				std::swap(m_Size, other.m_Size);
+				return *this;
+			}
+
+			for (size_t i{}; i < other.m_Size; ++i)
+			{
+				Emplace(std::move(other[i]));
+			}
+
+			other.Clear();
+			other.m_Pages.ReleasePages(0);
+
+			return *this;
+		}
+
+		template<typename ... Ts>
+		Reference Emplace(Ts&& ... args)
+		{
+			if (m_Size == Capacity())
+			{
+				m_Pages.AllocatePage(m_Pages.Size());
+			}
+
+			T* const pComponent{ new (GetSlot(m_Size)) T{ std::forward<Ts>(args)... } };
+			++m_Size;
+
+			return *pComponent;
+		}
+
+		/* Moves the last component into index and destroys the last slot, the pages are kept */
+		void Remove(const size_t index)
+		{
+			assert(index < m_Size);
+
+			const size_t lastIndex{ m_Size - 1 };
+
+			if (index != lastIndex)
+			{
+				(*this)[index] = std::move((*this)[lastIndex]);
+			}
+
+			std::destroy_at(GetSlot(lastIndex));
+			--m_Size;
+		}
+
+		void Swap(const size_t first, const size_t second)
+		{
+			using std::swap;
+			swap((*this)[first], (*this)[second]);
+		}
+
+		void Clear()
+		{
+			for (size_t i{}; i < m_Size; ++i)
+			{
+				std::destroy_at(GetSlot(i));
+			}
+
+			m_Size = 0;
+		}
+
+		/* Allocates every page needed for capacity components */
+		void Reserve(const size_t capacity)
+		{
+			while (Capacity() < capacity)
+			{
+				m_Pages.AllocatePage(m_Pages.Size());
+			}
+		}
+
+		/* Releases every page that holds no component */
+		void ShrinkToFit()
+		{
+			m_Pages.ReleasePages((m_Size + PageSize - 1) / PageSize);
+			m_Pages.ShrinkToFit();
+		}
+
+		[[nodiscard]] size_t Size() const { return m_Size; }
+		[[nodiscard]] size_t Capacity() const { return m_Pages.Size() * PageSize; }
+
+		[[nodiscard]] Reference operator[](const size_t index) { assert(index < m_Size); return *GetSlot(index); }
+		[[nodiscard]] ConstReference operator[](const size_t index) const { assert(index < m_Size); return *GetSlot(index); }
+
+	private:
+		[[nodiscard]] T* GetSlot(const size_t index) const { return m_Pages[index / PageSize] + index % PageSize; }
+
+		PageList<T, PageSize> m_Pages;
+		size_t m_Size;
+	};
+}
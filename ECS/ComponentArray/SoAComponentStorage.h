@@ -0,0 +1,187 @@
+#pragma once
+
+#include "../ECSConstants.h"
+
+#include <array> /* std::array */
+#include <assert.h> /* assert() */
+#include <memory_resource> /* std::pmr::memory_resource, std::pmr::vector */
+#include <tuple> /* std::tuple */
+#include <type_traits> /* std::conditional_t, std::is_same_v, ... */
+#include <utility> /* std::move(), std::swap() */
+
+namespace ECS
+{
+	/* Structure-of-arrays storage, every listed member of T gets its own contiguous column.
+	   Members has to list every data member of T, anything left out is lost when the component is stored.
+	   Opt in per component type:
+
+	   template<>
+	   struct ECS::ComponentTraits<TransformComponent>
+	   {
+		   using StorageType = ECS::SoAComponentStorage<TransformComponent, &TransformComponent::Position, &TransformComponent::Rotation, &TransformComponent::Scale>;
+	   };
+
+	   Views and the Registry then hand out a Reference proxy instead of a T&. It only stores the row, so a system that
+	   reads a single member through Get<&T::Member>() only touches the memory of that member's column */
+	template<typename T, auto ... Members>
+	class SoAComponentStorage final
+	{
+		static_assert(sizeof ... (Members) > 0, "SoAComponentStorage needs at least one member");
+		static_assert((std::is_member_object_pointer_v<decltype(Members)> && ...), "SoAComponentStorage only takes pointers to data members");
+
+		template<auto Member>
+		struct MemberTag final {};
+
+		template<typename Member>
+		struct MemberPointerTraits;
+		template<typename U>
+		struct MemberPointerTraits<U T::*> final
+		{
+			using Type = U;
+		};
+
+		template<auto Member>
+		static constexpr size_t ColumnIndex()
+		{
+			constexpr std::array<bool, sizeof ... (Members)> matches{ std::is_same_v<MemberTag<Member>, MemberTag<Members>>... };
+
+			size_t index{};
+			while (index < matches.size() && !matches[index])
+			{
+				++index;
+			}
+
+			return index;
+		}
+
+	public:
+		template<auto Member>
+		using MemberType = typename MemberPointerTraits<decltype(Member)>::Type;
+
+		template<bool IsConst>
+		class ReferenceProxy final
+		{
+			using StoragePointer = std::conditional_t<IsConst, const SoAComponentStorage*, SoAComponentStorage*>;
+
+		public:
+			ReferenceProxy(StoragePointer pStorage, const size_t index)
+				: m_pStorage{ pStorage }
+				, m_Index{ index }
+			{}
+
+			ReferenceProxy(const ReferenceProxy&) = default;
+
+			/* A mutable proxy can be passed where a const one is expected */
+			template<bool OtherIsConst> requires (IsConst && !OtherIsConst)
+			ReferenceProxy(const ReferenceProxy<OtherIsConst>& other)
+				: m_pStorage{ other.m_pStorage }
+				, m_Index{ other.m_Index }
+			{}
+
+			template<auto Member>
+			[[nodiscard]] decltype(auto) Get() const
+			{
+				return m_pStorage->template GetColumn<Member>()[m_Index];
+			}
+
+			/* Gathers every column back into a T */
+			[[nodiscard]] operator T() const
+			{
+				T component{};
+				((component.*Members = Get<Members>()), ...);
+				return component;
+			}
+
+			/* Scatters component over the columns */
+			const ReferenceProxy& operator=(const T& component) const
+			{
+				static_assert(!IsConst, "Cannot assign through a const reference");
+
+				((Get<Members>() = component.*Members), ...);
+				return *this;
+			}
+			/* Copies the row of other into this row, like assigning one T& to another would. It never re-points the proxy */
+			const ReferenceProxy& operator=(const ReferenceProxy& other) const
+			{
+				static_assert(!IsConst, "Cannot assign through a const reference");
+
+				((Get<Members>() = other.template Get<Members>()), ...);
+				return *this;
+			}
+
+		private:
+			friend class ReferenceProxy<true>;
+
+			StoragePointer m_pStorage;
+			size_t m_Index;
+		};
+
+		using Reference = ReferenceProxy<false>;
+		using ConstReference = ReferenceProxy<true>;
+
+		/* Every column is allocated from pResource */
+		explicit SoAComponentStorage(std::pmr::memory_resource* const pResource = std::pmr::get_default_resource())
+			: m_Columns{ std::pmr::vector<MemberType<Members>>(pResource)... }
+		{}
+
+		template<typename ... Ts>
+		Reference Emplace(Ts&& ... args)
+		{
+			T component{ std::forward<Ts>(args)... };
+
+			(GetColumn<Members>().push_back(std::move(component.*Members)), ...);
+
+			return Reference{ this, Size() - 1 };
+		}
+
+		/* Moves the last row into index and shrinks every column by one */
+		void Remove(const size_t index)
+		{
+			assert(index < Size());
+
+			const auto removeFromColumn([index](auto& column)->void
+				{
+					if (index != column.size() - 1)
+					{
+						column[index] = std::move(column.back());
+					}
+
+					column.pop_back();
+				});
+
+			(removeFromColumn(GetColumn<Members>()), ...);
+		}
+
+		void Swap(const size_t first, const size_t second)
+		{
+			using std::swap;
+			(swap(GetColumn<Members>()[first], GetColumn<Members>()[second]), ...);
+		}
+
+		void Clear() { (GetColumn<Members>().clear(), ...); }
+		void Reserve(const size_t capacity) { (GetColumn<Members>().reserve(capacity), ...); }
+		void ShrinkToFit() { (GetColumn<Members>().shrink_to_fit(), ...); }
+		[[nodiscard]] size_t Size() const { return std::get<0>(m_Columns).size(); }
+		[[nodiscard]] size_t Capacity() const { return std::get<0>(m_Columns).capacity(); }
+
+		[[nodiscard]] Reference operator[](const size_t index) { return Reference{ this, index }; }
+		[[nodiscard]] ConstReference operator[](const size_t index) const { return ConstReference{ this, index }; }
+
+		/* The contiguous column of a single member, in the same order as the entities of the ComponentArray */
+		template<auto Member>
+		[[nodiscard]] std::pmr::vector<MemberType<Member>>& GetColumn()
+		{
+			static_assert(ColumnIndex<Member>() < sizeof ... (Members), "Member is not stored by this SoAComponentStorage");
+			return std::get<ColumnIndex<Member>()>(m_Columns);
+		}
+		template<auto Member>
+		[[nodiscard]] const std::pmr::vector<MemberType<Member>>& GetColumn() const
+		{
+			static_assert(ColumnIndex<Member>() < sizeof ... (Members), "Member is not stored by this SoAComponentStorage");
+			return std::get<ColumnIndex<Member>()>(m_Columns);
+		}
+
+	private:
+		std::tuple<std::pmr::vector<MemberType<Members>>...> m_Columns;
+	};
+}
@@ -0,0 +1,58 @@
+#pragma once
+
+#include "../ECSConstants.h"
+
+#include <assert.h> /* assert() */
+#include <limits> /* std::numeric_limits */
+#include <memory_resource> /* std::pmr::memory_resource */
+#include <type_traits> /* std::is_empty_v */
+
+namespace ECS
+{
+	/* Storage for empty tag components, which is the default for every std::is_empty_v type.
+	   A tag has no state, so only the amount of components is stored and every entity shares one instance.
+	   The ComponentArray still tracks which entities have the tag, but the components themselves cost no memory and reading one never touches memory.
+	   Capacity() never limits the ComponentArray, whose capacity then is the one of its entities */
+	template<typename T>
+	class TagComponentStorage final
+	{
+		static_assert(std::is_empty_v<T>, "TagComponentStorage only supports empty types");
+
+	public:
+		using Reference = T&;
+		using ConstReference = const T&;
+
+		explicit TagComponentStorage(std::pmr::memory_resource* const = std::pmr::get_default_resource())
+			: m_Size{}
+		{}
+
+		template<typename ... Ts>
+		Reference Emplace(Ts&& ...)
+		{
+			++m_Size;
+			return m_Instance;
+		}
+
+		void Remove([[maybe_unused]] const size_t index)
+		{
+			assert(index < m_Size);
+			--m_Size;
+		}
+
+		void Swap(const size_t, const size_t) {}
+
+		void Clear() { m_Size = 0; }
+		void Reserve(const size_t) {}
+		void ShrinkToFit() {}
+		[[nodiscard]] size_t Size() const { return m_Size; }
+		[[nodiscard]] size_t Capacity() const { return std::numeric_limits<size_t>::max(); }
+
+		[[nodiscard]] Reference operator[](const size_t) { return m_Instance; }
+		[[nodiscard]] ConstReference operator[](const size_t) const { return m_Instance; }
+
+	private:
+		inline static T m_Instance{};
+
+		size_t m_Size;
+	};
+}
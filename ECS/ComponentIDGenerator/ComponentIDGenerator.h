@@ -1,26 +1,46 @@
 #pragma once
 #include "../ECSConstants.h"
-#include "../Utils/Utils.h"
 
-#include <string> /* std::string */
+#include <assert.h> /* assert() */
+#include <atomic> /* std::atomic */
+#include <exception> /* std::terminate() */
+#include <type_traits> /* std::remove_cvref_t */
 
 namespace ECS
 {
-	template<typename T>
-	[[nodiscard]] consteval ComponentType GenerateComponentID()
+	class ComponentIDGenerator final
 	{
-		using namespace Utils;
+	public:
+		/* Every type gets the next sequential ID the first time it is asked for, so IDs are dense and can index the Registry's pool table */
+		template<typename T>
+		[[nodiscard]] static ComponentType Get()
+		{
+			static const ComponentType id{ GenerateID() };
+
+			return id;
+		}
+
+	private:
+		/* Running out of IDs would make two types share a pool, so it terminates in release builds as well */
+		[[nodiscard]] static ComponentType GenerateID()
+		{
+			const size_t id{ m_Counter++ };
 
-		constexpr std::string_view typeName(ConstexprTypeName<T>());
+			if (id >= MaxComponentTypes)
+			{
+				assert(false && "ComponentIDGenerator::Get() > The maximum amount of component types has been registered");
+				std::terminate();
+			}
 
-		constexpr ComponentType hash(
-			static_cast<ComponentType>(
-				ConstexprStringHash(
-					typeName.data(),
-					typeName.size()
-				))
-		);
+			return static_cast<ComponentType>(id);
+		}
 
-		return hash;
+		inline static std::atomic<size_t> m_Counter{}; /* Wider than ComponentType, so it cannot wrap around to an ID that is in use */
+	};
+
+	template<typename T>
+	[[nodiscard]] __forceinline ComponentType GenerateComponentID()
+	{
+		return ComponentIDGenerator::Get<std::remove_cvref_t<T>>();
 	}
 }
\ No newline at end of file
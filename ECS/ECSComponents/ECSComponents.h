@@ -23,3 +23,11 @@ public:
 	float Mass{ ECS::Utils::RandomFloat(0.f, 100.f) };
 	Point2f Velocity{};
 };
+
+class AIComponent final
+{
+public:
+	Point2f Target{ CreateRandomPoint2f(0.f, 1000.f) };
+	Point2f Direction{};
+	float ThinkTimer{ ECS::Utils::RandomFloat(0.f, 1.f) };
+};
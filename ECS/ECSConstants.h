@@ -4,16 +4,49 @@
 #include <cstdint>
 #include <limits>
 
+#ifndef _MSC_VER
+#	define __forceinline inline __attribute__((always_inline))
+#endif
+
 namespace ECS
 {
-	using Entity = uint32_t; /* This supports ~4 billion possible entities, seems like enough */
+	using Entity = uint32_t; /* The lower EntityIndexBits are the index, the upper bits are the version of that index */
 	using ComponentType = uint8_t; /* This supports 256 possible component types, seems like enough */
+	using Tick = uint32_t; /* Change detection counter of a Registry, see Registry::AdvanceTick() */
+
+	constexpr Entity EntityIndexBits{ 24 }; /* This supports ~16 million alive entities and 255 versions per index */
+	constexpr Entity EntityIndexMask{ (Entity(1) << EntityIndexBits) - 1 };
+	constexpr Entity EntityVersionMask{ ~EntityIndexMask };
 
-	constexpr Entity MaxEntities{ std::numeric_limits<Entity>::max() - 1 };
+	constexpr Entity MaxEntities{ EntityIndexMask - 1 };
 	constexpr ComponentType MaxComponentTypes{ std::numeric_limits<ComponentType>::max() -1 };
 
 	using EntitySignature = std::bitset<MaxComponentTypes>;
 
+	constexpr size_t SparsePageSize{ 4096 }; /* Amount of entity indices per page of a sparse array */
+	constexpr size_t ArchetypeChunkSize{ 16 * 1024 }; /* Amount of bytes per chunk of an Archetype */
+	constexpr size_t ComponentPageSize{ 1024 }; /* Amount of components per page of a PagedComponentStorage */
+
 	constexpr Entity InvalidEntityID{ std::numeric_limits<Entity>::max() };
 	constexpr ComponentType InvalidComponentID{ std::numeric_limits<ComponentType>::max() };
+
+	/* The all-ones version is never handed out, so an InvalidEntityID sparse slot can never match a valid entity */
+	constexpr Entity MaxEntityVersion{ (EntityVersionMask >> EntityIndexBits) - 1 };
+
+	[[nodiscard]] constexpr Entity GetEntityIndex(const Entity entity) { return entity & EntityIndexMask; }
+	[[nodiscard]] constexpr Entity GetEntityVersion(const Entity entity) { return entity >> EntityIndexBits; }
+	[[nodiscard]] constexpr Entity CreateEntityID(const Entity index, const Entity version) { return (version << EntityIndexBits) | (index & EntityIndexMask); }
+
+	/* Whether tick came after since. Ticks wrap around, so this only holds while they are less than half the range apart */
+	[[nodiscard]] constexpr bool IsNewerTick(const Tick tick, const Tick since) { return static_cast<int32_t>(tick - since) > 0; }
+
+	[[nodiscard]] constexpr Entity GetNextEntityVersion(const Entity entity)
+	{
+		const Entity version{ GetEntityVersion(entity) };
+
+		return version < MaxEntityVersion ? version + 1 : 0;
+	}
+
+	/* The handle the index of a released entity is handed out with next. Bumping the version makes every handle to the released entity stale */
+	[[nodiscard]] constexpr Entity GetRecycledEntityID(const Entity entity) { return CreateEntityID(GetEntityIndex(entity), GetNextEntityVersion(entity)); }
 }
\ No newline at end of file
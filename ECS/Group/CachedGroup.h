@@ -0,0 +1,103 @@
+#pragma once
+
+#include "../ECSConstants.h"
+#include "../ComponentArray/ComponentArray.h"
+#include "../ComponentIDGenerator/ComponentIDGenerator.h"
+#include "../SparseSet/SparseSet.h"
+#include "Group.h"
+
+#include <memory_resource> /* std::pmr::memory_resource */
+#include <tuple> /* std::tuple */
+#include <type_traits> /* std::is_const_v */
+#include <utility> /* std::move(), std::as_const() */
+
+namespace ECS
+{
+	/* A non-owning group keeps a packed list of every entity that has all of Ts, updated as components are added and removed.
+	   It does not reorder the pools, so any amount of cached groups can share them, even with an owning group.
+	   Iterating it never re-tests membership, only the components are looked up.
+	   A const T is only handed out as const and is never stamped as modified */
+	template<typename ... Ts>
+	class CachedGroup final : public IGroup
+	{
+		template<typename T>
+		using PoolType = GroupPoolType<T>;
+
+		using GroupContainerType = std::tuple<PoolType<Ts>&...>;
+
+	public:
+		/* The list of matching entities is allocated from pResource */
+		explicit CachedGroup(GroupContainerType&& components, std::pmr::memory_resource* const pResource = std::pmr::get_default_resource())
+			: m_Components{ std::move(components) }
+			, m_Entities{ pResource }
+		{
+			const DenseSet<Entity>& entities{ std::get<0>(m_Components).GetEntities() };
+
+			for (size_t i{}; i < entities.Size(); ++i)
+			{
+				OnComponentAdded(entities.GetFirstAt(i));
+			}
+		}
+
+		CachedGroup(const CachedGroup&) noexcept = delete;
+		CachedGroup(CachedGroup&&) noexcept = delete;
+		CachedGroup& operator=(const CachedGroup&) noexcept = delete;
+		CachedGroup& operator=(CachedGroup&&) noexcept = delete;
+
+		virtual void OnComponentAdded(const Entity entity) override
+		{
+			if ((std::get<PoolType<Ts>&>(m_Components).HasEntity(entity) && ...))
+			{
+				m_Entities.Add(entity);
+			}
+		}
+
+		virtual void OnComponentRemoved(const Entity entity) override
+		{
+			m_Entities.Remove(entity);
+		}
+
+		[[nodiscard]] virtual bool Observes(const ComponentType cType) const override
+		{
+			return ((GenerateComponentID<Ts>() == cType) || ...);
+		}
+		[[nodiscard]] virtual bool Owns(const ComponentType) const override
+		{
+			return false;
+		}
+
+		[[nodiscard]] bool Contains(const Entity entity) const { return m_Entities.Contains(entity); }
+		[[nodiscard]] size_t Size() const { return m_Entities.Size(); }
+
+		/* Same contract as View::ForEach(). Every component is still one sparse lookup in its pool, the packed indices are not cached
+		   because any removal, sort or owning group reorders the pools underneath. What the group saves is visiting and testing the
+		   entities that do not match, see BENCHMARK_CUSTOMECS_CACHED_GROUP_UPDATE */
+		template<typename Function>
+		void ForEach(Function&& function) const
+		{
+			for (size_t i{ m_Entities.Size() }; i > 0; --i)
+			{
+				const Entity entity{ m_Entities.GetAt(i - 1) };
+
+				function(GetComponent<Ts>(entity)...);
+			}
+		}
+
+	private:
+		template<typename T>
+		[[nodiscard]] __forceinline ComponentReference<T> GetComponent(const Entity entity) const
+		{
+			if constexpr (std::is_const_v<T>)
+			{
+				return std::as_const(std::get<PoolType<T>&>(m_Components)).GetComponent(entity);
+			}
+			else
+			{
+				return std::get<PoolType<T>&>(m_Components).ModifyComponent(entity);
+			}
+		}
+
+		GroupContainerType m_Components;
+		SparseSet<Entity> m_Entities;
+	};
+}
\ No newline at end of file
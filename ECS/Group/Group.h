@@ -0,0 +1,134 @@
+#pragma once
+
+#include "../ECSConstants.h"
+#include "../ComponentArray/ComponentArray.h"
+#include "../ComponentIDGenerator/ComponentIDGenerator.h"
+
+#include <span> /* std::span */
+#include <tuple> /* std::tuple */
+#include <type_traits> /* std::remove_const_t, std::is_const_v */
+#include <utility> /* std::move(), std::index_sequence */
+
+namespace ECS
+{
+	class IGroup
+	{
+	public:
+		virtual ~IGroup() = default;
+
+		/* Called by the Registry after a component of an observed type has been added to entity */
+		virtual void OnComponentAdded(const Entity entity) = 0;
+		/* Called by the Registry before a component of an observed type is removed from entity */
+		virtual void OnComponentRemoved(const Entity entity) = 0;
+
+		[[nodiscard]] virtual bool Observes(const ComponentType cType) const = 0;
+		[[nodiscard]] virtual bool Owns(const ComponentType cType) const = 0;
+	};
+
+	/* The pool of a group element, a const T is kept in the same ComponentArray as a T */
+	template<typename T>
+	using GroupPoolType = ComponentArray<std::remove_const_t<T>>;
+
+	/* An owning group keeps every entity that has all of Ts at the front of each owned ComponentArray, in the same order.
+	   Iterating it is a plain indexed loop over parallel arrays, without any sparse lookups.
+	   A const T is only handed out as const and is never stamped as modified, so it does not show up in Changed<T> filters.
+	   A ComponentArray can be owned by at most one group, whether it is const in it or not */
+	template<typename ... Ts>
+	class Group final : public IGroup
+	{
+		template<typename T>
+		using PoolType = GroupPoolType<T>;
+
+		using GroupContainerType = std::tuple<PoolType<Ts>&...>;
+
+	public:
+		explicit Group(GroupContainerType&& components)
+			: m_Components{ std::move(components) }
+			, m_Size{}
+		{
+			const PoolType<FirstType>& pool{ std::get<0>(m_Components) };
+
+			for (size_t i{}; i < pool.Size(); ++i)
+			{
+				OnComponentAdded(pool.GetEntities().GetFirstAt(i));
+			}
+		}
+
+		Group(const Group&) noexcept = delete;
+		Group(Group&&) noexcept = delete;
+		Group& operator=(const Group&) noexcept = delete;
+		Group& operator=(Group&&) noexcept = delete;
+
+		virtual void OnComponentAdded(const Entity entity) override
+		{
+			if ((std::get<PoolType<Ts>&>(m_Components).HasEntity(entity) && ...) && !Contains(entity))
+			{
+				(std::get<PoolType<Ts>&>(m_Components).SwapAt(std::get<PoolType<Ts>&>(m_Components).GetIndex(entity), m_Size), ...);
+				++m_Size;
+			}
+		}
+
+		virtual void OnComponentRemoved(const Entity entity) override
+		{
+			if (Contains(entity))
+			{
+				--m_Size;
+				(std::get<PoolType<Ts>&>(m_Components).SwapAt(std::get<PoolType<Ts>&>(m_Components).GetIndex(entity), m_Size), ...);
+			}
+		}
+
+		[[nodiscard]] virtual bool Observes(const ComponentType cType) const override
+		{
+			return ((GenerateComponentID<Ts>() == cType) || ...);
+		}
+		[[nodiscard]] virtual bool Owns(const ComponentType cType) const override
+		{
+			return Observes(cType);
+		}
+
+		[[nodiscard]] bool Contains(const Entity entity) const
+		{
+			const PoolType<FirstType>& pool{ std::get<0>(m_Components) };
+
+			return pool.HasEntity(entity) && pool.GetIndex(entity) < m_Size;
+		}
+
+		[[nodiscard]] size_t Size() const { return m_Size; }
+
+		/* Same contract as View::ForEach() */
+		template<typename Function>
+		void ForEach(Function&& function) const
+		{
+			(MarkModified<Ts>(), ...);
+
+			for (size_t i{ m_Size }; i > 0; --i)
+			{
+				function(static_cast<ComponentReference<Ts>>(std::get<PoolType<Ts>&>(m_Components).GetComponentAt(i - 1))...);
+			}
+		}
+
+		/* Function is called once as function(std::span<Ts>...), the matching entities are the front of every owned pool */
+		template<typename Function>
+		void ForEachChunk(Function&& function) const
+		{
+			(MarkModified<Ts>(), ...);
+
+			function(std::span<Ts>{ std::get<PoolType<Ts>&>(m_Components).GetComponents().first(m_Size) }...);
+		}
+
+	private:
+		template<typename T>
+		void MarkModified() const
+		{
+			if constexpr (!std::is_const_v<T>)
+			{
+				std::get<PoolType<T>&>(m_Components).MarkModifiedAt(0, m_Size);
+			}
+		}
+
+		using FirstType = std::tuple_element_t<0, std::tuple<Ts...>>;
+
+		GroupContainerType m_Components;
+		size_t m_Size;
+	};
+}
\ No newline at end of file
@@ -5,9 +5,22 @@
 struct Point2f final
 {
 	float x, y;
+
+	constexpr Point2f& operator+=(const Point2f& other) { x += other.x; y += other.y; return *this; }
+	constexpr Point2f& operator-=(const Point2f& other) { x -= other.x; y -= other.y; return *this; }
+	constexpr Point2f& operator*=(const float scalar) { x *= scalar; y *= scalar; return *this; }
+
+	[[nodiscard]] constexpr bool operator==(const Point2f&) const = default;
 };
 
+static_assert(sizeof(Point2f) == 2 * sizeof(float), "The batch kernels in Point2fMath.h treat arrays of Point2f as arrays of floats");
+
+[[nodiscard]] __forceinline constexpr Point2f operator+(Point2f a, const Point2f& b) { return a += b; }
+[[nodiscard]] __forceinline constexpr Point2f operator-(Point2f a, const Point2f& b) { return a -= b; }
+[[nodiscard]] __forceinline constexpr Point2f operator*(Point2f a, const float scalar) { return a *= scalar; }
+[[nodiscard]] __forceinline constexpr Point2f operator*(const float scalar, Point2f a) { return a *= scalar; }
+
 [[nodiscard]] __forceinline static Point2f CreateRandomPoint2f(float min, float max)
 {
 	return Point2f{ ECS::Utils::RandomFloat(min, max), ECS::Utils::RandomFloat(min, max) };
-}
\ No newline at end of file
+}
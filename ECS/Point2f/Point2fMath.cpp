@@ -0,0 +1,221 @@
+#include "Point2fMath.h"
+
+#include <assert.h> /* assert() */
+
+#if defined(_M_X64) || defined(_M_IX86) || defined(__x86_64__) || defined(__i386__)
+#define ECS_POINT2F_MATH_X86
+#include <immintrin.h> /* SSE and AVX intrinsics */
+#ifdef _MSC_VER
+#include <intrin.h> /* __cpuid(), __cpuidex() */
+#endif
+#endif
+
+/* MSVC lets every function use AVX intrinsics, other compilers need the target enabled per function */
+#if defined(ECS_POINT2F_MATH_X86) && !defined(_MSC_VER)
+#define ECS_TARGET_AVX2 __attribute__((target("avx2")))
+#else
+#define ECS_TARGET_AVX2
+#endif
+
+namespace ECS::Math
+{
+	namespace
+	{
+		/* A span of Point2f is handled as a span of twice as many floats */
+		using AddKernel = void(*)(float* pDestination, const float* pSource, const size_t nrOfFloats);
+		using MultiplyAddKernel = void(*)(float* pDestination, const float* pSource, const float scalar, const size_t nrOfFloats);
+		using ScaleKernel = void(*)(float* pDestination, const float scalar, const size_t nrOfFloats);
+
+		void AddScalar(float* pDestination, const float* pSource, const size_t nrOfFloats)
+		{
+			for (size_t i{}; i < nrOfFloats; ++i)
+			{
+				pDestination[i] += pSource[i];
+			}
+		}
+		void MultiplyAddScalar(float* pDestination, const float* pSource, const float scalar, const size_t nrOfFloats)
+		{
+			for (size_t i{}; i < nrOfFloats; ++i)
+			{
+				pDestination[i] += pSource[i] * scalar;
+			}
+		}
+		void ScaleScalar(float* pDestination, const float scalar, const size_t nrOfFloats)
+		{
+			for (size_t i{}; i < nrOfFloats; ++i)
+			{
+				pDestination[i] *= scalar;
+			}
+		}
+
+#ifdef ECS_POINT2F_MATH_X86
+		/* SSE2 is part of every x64 CPU, so this path never needs a CPU check there. 4 floats are 2 points */
+		void AddSSE(float* pDestination, const float* pSource, const size_t nrOfFloats)
+		{
+			size_t i{};
+
+			for (; i + 4 <= nrOfFloats; i += 4)
+			{
+				_mm_storeu_ps(pDestination + i, _mm_add_ps(_mm_loadu_ps(pDestination + i), _mm_loadu_ps(pSource + i)));
+			}
+
+			AddScalar(pDestination + i, pSource + i, nrOfFloats - i);
+		}
+		void MultiplyAddSSE(float* pDestination, const float* pSource, const float scalar, const size_t nrOfFloats)
+		{
+			const __m128 scalars{ _mm_set1_ps(scalar) };
+			size_t i{};
+
+			for (; i + 4 <= nrOfFloats; i += 4)
+			{
+				_mm_storeu_ps(pDestination + i, _mm_add_ps(_mm_loadu_ps(pDestination + i), _mm_mul_ps(_mm_loadu_ps(pSource + i), scalars)));
+			}
+
+			MultiplyAddScalar(pDestination + i, pSource + i, scalar, nrOfFloats - i);
+		}
+		void ScaleSSE(float* pDestination, const float scalar, const size_t nrOfFloats)
+		{
+			const __m128 scalars{ _mm_set1_ps(scalar) };
+			size_t i{};
+
+			for (; i + 4 <= nrOfFloats; i += 4)
+			{
+				_mm_storeu_ps(pDestination + i, _mm_mul_ps(_mm_loadu_ps(pDestination + i), scalars));
+			}
+
+			ScaleScalar(pDestination + i, scalar, nrOfFloats - i);
+		}
+
+		/* 8 floats are 4 points, the remainder goes through the SSE path */
+		ECS_TARGET_AVX2 void AddAVX2(float* pDestination, const float* pSource, const size_t nrOfFloats)
+		{
+			size_t i{};
+
+			for (; i + 8 <= nrOfFloats; i += 8)
+			{
+				_mm256_storeu_ps(pDestination + i, _mm256_add_ps(_mm256_loadu_ps(pDestination + i), _mm256_loadu_ps(pSource + i)));
+			}
+
+			AddSSE(pDestination + i, pSource + i, nrOfFloats - i);
+		}
+		ECS_TARGET_AVX2 void MultiplyAddAVX2(float* pDestination, const float* pSource, const float scalar, const size_t nrOfFloats)
+		{
+			const __m256 scalars{ _mm256_set1_ps(scalar) };
+			size_t i{};
+
+			for (; i + 8 <= nrOfFloats; i += 8)
+			{
+				/* No fused multiply-add, it rounds once where the other paths round twice and the results have to match on every CPU */
+				_mm256_storeu_ps(pDestination + i, _mm256_add_ps(_mm256_loadu_ps(pDestination + i), _mm256_mul_ps(_mm256_loadu_ps(pSource + i), scalars)));
+			}
+
+			MultiplyAddSSE(pDestination + i, pSource + i, scalar, nrOfFloats - i);
+		}
+		ECS_TARGET_AVX2 void ScaleAVX2(float* pDestination, const float scalar, const size_t nrOfFloats)
+		{
+			const __m256 scalars{ _mm256_set1_ps(scalar) };
+			size_t i{};
+
+			for (; i + 8 <= nrOfFloats; i += 8)
+			{
+				_mm256_storeu_ps(pDestination + i, _mm256_mul_ps(_mm256_loadu_ps(pDestination + i), scalars));
+			}
+
+			ScaleSSE(pDestination + i, scalar, nrOfFloats - i);
+		}
+
+		[[nodiscard]] bool IsAVX2Supported()
+		{
+#ifdef _MSC_VER
+			int registers[4]{};
+
+			__cpuid(registers, 0);
+			if (registers[0] < 7)
+			{
+				return false;
+			}
+
+			__cpuid(registers, 1);
+			const bool hasOSXSave{ (registers[2] & (1 << 27)) != 0 };
+			const bool hasAVX{ (registers[2] & (1 << 28)) != 0 };
+
+			/* The OS has to save the YMM registers on a context switch */
+			if (!hasOSXSave || !hasAVX || (_xgetbv(0) & 0x6) != 0x6)
+			{
+				return false;
+			}
+
+			__cpuidex(registers, 7, 0);
+			return (registers[1] & (1 << 5)) != 0;
+#else
+			__builtin_cpu_init();
+			return __builtin_cpu_supports("avx2");
+#endif
+		}
+#endif
+
+		struct Kernels final
+		{
+			InstructionSet Set;
+			AddKernel Add;
+			MultiplyAddKernel MultiplyAdd;
+			ScaleKernel Scale;
+		};
+
+		[[nodiscard]] Kernels SelectKernels()
+		{
+#ifdef ECS_POINT2F_MATH_X86
+			if (IsAVX2Supported())
+			{
+				return Kernels{ InstructionSet::AVX2, &AddAVX2, &MultiplyAddAVX2, &ScaleAVX2 };
+			}
+
+			return Kernels{ InstructionSet::SSE, &AddSSE, &MultiplyAddSSE, &ScaleSSE };
+#else
+			return Kernels{ InstructionSet::Scalar, &AddScalar, &MultiplyAddScalar, &ScaleScalar };
+#endif
+		}
+
+		[[nodiscard]] const Kernels& GetKernels()
+		{
+			static const Kernels kernels{ SelectKernels() };
+			return kernels;
+		}
+
+		[[nodiscard]] float* ToFloats(const std::span<Point2f> points) { return &points.data()->x; }
+		[[nodiscard]] const float* ToFloats(const std::span<const Point2f> points) { return &points.data()->x; }
+	}
+
+	InstructionSet GetInstructionSet()
+	{
+		return GetKernels().Set;
+	}
+
+	void Add(std::span<Point2f> destination, std::span<const Point2f> source)
+	{
+		assert(destination.size() == source.size() && "Math::Add() > Both spans must be equally long");
+
+		if (!destination.empty())
+		{
+			GetKernels().Add(ToFloats(destination), ToFloats(source), destination.size() * 2);
+		}
+	}
+
+	void MultiplyAdd(std::span<Point2f> destination, std::span<const Point2f> source, const float scalar)
+	{
+		assert(destination.size() == source.size() && "Math::MultiplyAdd() > Both spans must be equally long");
+
+		if (!destination.empty())
+		{
+			GetKernels().MultiplyAdd(ToFloats(destination), ToFloats(source), scalar, destination.size() * 2);
+		}
+	}
+
+	void Scale(std::span<Point2f> destination, const float scalar)
+	{
+		if (!destination.empty())
+		{
+			GetKernels().Scale(ToFloats(destination), scalar, destination.size() * 2);
+		}
+	}
+}
@@ -0,0 +1,28 @@
+#pragma once
+
+#include "Point2f.h"
+
+#include <span> /* std::span */
+
+namespace ECS::Math
+{
+	enum class InstructionSet
+	{
+		Scalar,
+		SSE,
+		AVX2
+	};
+
+	/* The widest instruction set supported by both the build and the CPU, detected once at startup.
+	   Every batch kernel below runs on it */
+	[[nodiscard]] InstructionSet GetInstructionSet();
+
+	/* destination[i] += source[i], both spans must be equally long */
+	void Add(std::span<Point2f> destination, std::span<const Point2f> source);
+
+	/* destination[i] += source[i] * scalar, both spans must be equally long. Integrates Position by Velocity * dt in one pass */
+	void MultiplyAdd(std::span<Point2f> destination, std::span<const Point2f> source, const float scalar);
+
+	/* destination[i] *= scalar */
+	void Scale(std::span<Point2f> destination, const float scalar);
+}
@@ -5,9 +5,15 @@
 
 namespace ECS
 {
-	Registry::Registry()
-		: Entities{}
+	Registry::Registry(std::pmr::memory_resource* const pResource)
+		: Entities{ pResource }
+		, RecycledEntities{ pResource }
+		, Signatures{ pResource }
 		, CurrentEntityCounter{}
+		, ReleasedPerPool{ pResource }
+		, CurrentTick{ 1 }
+		, pThreadPool{}
+		, pMemoryResource{ pResource }
 	{}
 
 	Registry::~Registry()
@@ -16,28 +22,46 @@ namespace ECS
 	}
 
 	Registry::Registry(Registry&& other) noexcept
-		: ComponentPools{ std::move(other.ComponentPools) }
-		, Entities{ std::move(other.Entities) }
-		, CurrentEntityCounter{ std::move(other.CurrentEntityCounter) }
+		: Entities{ std::move(other.Entities) }
 		, RecycledEntities{ std::move(other.RecycledEntities) }
+		, Signatures{ std::move(other.Signatures) }
+		, CurrentEntityCounter{ std::move(other.CurrentEntityCounter) }
+		, ComponentPools{ std::move(other.ComponentPools) }
+		, ReleasedPerPool{ std::move(other.ReleasedPerPool) }
+		, CurrentTick{ other.CurrentTick }
+		, Groups{ std::move(other.Groups) }
+		, pThreadPool{ other.pThreadPool }
+		, pMemoryResource{ other.pMemoryResource }
 	{
 		other.Entities.Clear();
 		other.CurrentEntityCounter = 0;
 		other.ComponentPools.clear();
 		other.RecycledEntities.clear();
+		other.Signatures.clear();
+		other.ReleasedPerPool.clear();
+		other.Groups.clear();
 	}
 
 	Registry& Registry::operator=(Registry&& other) noexcept
 	{
 		Entities = std::move(other.Entities);
 		CurrentEntityCounter = std::move(other.CurrentEntityCounter);
+		Groups = std::move(other.Groups);
 		ComponentPools = std::move(other.ComponentPools);
 		RecycledEntities = std::move(other.RecycledEntities);
+		Signatures = std::move(other.Signatures);
+		ReleasedPerPool = std::move(other.ReleasedPerPool);
+		CurrentTick = other.CurrentTick;
+		pThreadPool = other.pThreadPool;
+		pMemoryResource = other.pMemoryResource;
 
 		other.Entities.Clear();
 		other.CurrentEntityCounter = 0;
 		other.ComponentPools.clear();
 		other.RecycledEntities.clear();
+		other.Signatures.clear();
+		other.ReleasedPerPool.clear();
+		other.Groups.clear();
 
 		return *this;
 	}
@@ -56,10 +80,15 @@ namespace ECS
 			entity = CurrentEntityCounter++;
 		}
 
-		assert(entity != InvalidEntityID && "Registry::CreateEntity() > The maximum amount of entities has been created. Consider increasing MAX_ENTITIES");
+		assert(GetEntityIndex(entity) <= MaxEntities && "Registry::CreateEntity() > The maximum amount of entities has been created. Consider increasing EntityIndexBits");
 
 		Entities.Add(entity);
 
+		if (Signatures.size() <= GetEntityIndex(entity))
+		{
+			Signatures.resize(GetEntityIndex(entity) + 1);
+		}
+
 		return entity;
 	}
 
@@ -67,11 +96,8 @@ namespace ECS
 	{
 		if (HasEntity(entity))
 		{
-			RemoveAllComponents(entity); // [TODO]: Come up with a better way to handle this
-
-			Entities.Remove(entity);
-
-			RecycledEntities.push_back(entity);
+			RemoveAllComponents(entity);
+			RecycleEntity(entity);
 
 			return true;
 		}
@@ -79,11 +105,124 @@ namespace ECS
 		return false;
 	}
 
+	size_t Registry::ReleaseEntities(const std::span<const Entity> entities)
+	{
+		if (ReleasedPerPool.size() < ComponentPools.size())
+		{
+			ReleasedPerPool.resize(ComponentPools.size());
+		}
+
+		/* Every entity is only handed to the pools in its signature, so the cost follows the amount of components released */
+		for (const Entity entity : entities)
+		{
+			if (HasEntity(entity))
+			{
+				for (const auto& pGroup : Groups)
+				{
+					pGroup->OnComponentRemoved(entity);
+				}
+
+				ForEachComponentType(Signatures[GetEntityIndex(entity)], [this, entity](const size_t cType)->void
+					{
+						ReleasedPerPool[cType].push_back(entity);
+					});
+			}
+		}
+
+		for (size_t cType{}; cType < ComponentPools.size(); ++cType)
+		{
+			if (!ReleasedPerPool[cType].empty())
+			{
+				ComponentPools[cType]->Remove(ReleasedPerPool[cType]);
+				ReleasedPerPool[cType].clear();
+			}
+		}
+
+		size_t released{};
+
+		for (const Entity entity : entities)
+		{
+			if (HasEntity(entity))
+			{
+				RecycleEntity(entity);
+				++released;
+			}
+		}
+
+		return released;
+	}
+
+	bool Registry::IsOwnedByGroup(const ComponentType cType) const
+	{
+		return std::any_of(Groups.cbegin(), Groups.cend(), [cType](const std::unique_ptr<IGroup>& pGroup)->bool
+			{
+				return pGroup->Owns(cType);
+			});
+	}
+
 	void Registry::RemoveAllComponents(const Entity entity)
 	{
+		for (const auto& pGroup : Groups)
+		{
+			pGroup->OnComponentRemoved(entity);
+		}
+
+		/* Only the pools in the signature of entity can contain it */
+		ForEachComponentType(Signatures[GetEntityIndex(entity)], [this, entity](const size_t cType)->void
+			{
+				ComponentPools[cType]->Remove(entity);
+			});
+	}
+
+	void Registry::RecycleEntity(const Entity entity)
+	{
+		Entities.Remove(entity);
+		Signatures[GetEntityIndex(entity)].reset();
+		RecycledEntities.push_back(GetRecycledEntityID(entity));
+	}
+
+	void Registry::OnComponentAdded(const ComponentType cType, const Entity entity)
+	{
+		for (const auto& pGroup : Groups)
+		{
+			if (pGroup->Observes(cType))
+			{
+				pGroup->OnComponentAdded(entity);
+			}
+		}
+	}
+
+	void Registry::OnComponentRemoved(const ComponentType cType, const Entity entity)
+	{
+		for (const auto& pGroup : Groups)
+		{
+			if (pGroup->Observes(cType))
+			{
+				pGroup->OnComponentRemoved(entity);
+			}
+		}
+	}
+
+	void Registry::Reserve(const size_t entities)
+	{
+		Entities.Reserve(entities);
+		Entities.AllocatePages(0, entities); /* While at most entities are alive, every index stays below entities */
+		RecycledEntities.reserve(entities);
+		Signatures.reserve(entities);
+	}
+
+	void Registry::ShrinkToFit()
+	{
+		Entities.ShrinkToFit();
+		RecycledEntities.shrink_to_fit();
+		Signatures.shrink_to_fit();
+
 		for (const auto& compArray : ComponentPools)
 		{
-			compArray.second->Remove(entity);
+			if (compArray)
+			{
+				compArray->ShrinkToFit();
+			}
 		}
 	}
 
@@ -97,41 +236,52 @@ namespace ECS
 		Entities.Clear();
 		CurrentEntityCounter = 0;
 
-		for (const auto& [component, compArray] : ComponentPools)
+		/* Groups reference the pools, so they have to go first */
+		Groups.clear();
+
+		for (const auto& compArray : ComponentPools)
 		{
-			compArray->RemoveAll();
+			if (compArray)
+			{
+				compArray->RemoveAll();
+			}
 		}
 
 		ComponentPools.clear();
 		RecycledEntities.clear();
+		Signatures.clear();
+		ReleasedPerPool.clear();
 	}
 
-	const std::unique_ptr<IComponentArray>& Registry::GetComponentArray(const size_t cType) const
+	Tick Registry::AdvanceTick()
 	{
-		const auto cIt{ std::find_if(ComponentPools.cbegin(), ComponentPools.cend(), [cType](const auto& kvPair)->bool
+		const Tick endedTick{ CurrentTick++ };
+
+		for (const auto& compArray : ComponentPools)
+		{
+			if (compArray)
 			{
-				return kvPair.first == cType;
-			}) };
+				compArray->SetCurrentTick(CurrentTick);
+			}
+		}
 
-		assert(cIt != ComponentPools.end());
+		return endedTick;
+	}
 
-		return cIt->second;
+	const std::unique_ptr<IComponentArray>& Registry::GetComponentArray(const size_t cType) const
+	{
+		assert(cType < ComponentPools.size());
+
+		return ComponentPools[cType];
 	}
 
 	std::unique_ptr<IComponentArray>& Registry::GetComponentArray(const size_t cType)
 	{
-		const auto it{ std::find_if(ComponentPools.begin(), ComponentPools.end(), [cType](const auto& kvPair)->bool
-			{
-				return kvPair.first == cType;
-			}) };
-
-		if (it != ComponentPools.end())
+		if (ComponentPools.size() <= cType)
 		{
-			return it->second;
-		}
-		else
-		{
-			return ComponentPools.emplace_back(std::make_pair(cType, nullptr)).second;
+			ComponentPools.resize(cType + 1);
 		}
+
+		return ComponentPools[cType];
 	}
 }
\ No newline at end of file
@@ -3,18 +3,29 @@
 #include "../ECSConstants.h"
 #include "../ComponentArray/ComponentArray.h"
 #include "../ComponentIDGenerator/ComponentIDGenerator.h"
+#include "../Group/CachedGroup.h"
+#include "../Group/Group.h"
 #include "../View/View.h"
 #include "../SparseSet/SparseSet.h"
+#include "../ThreadPool/ThreadPool.h"
 
+#include <algorithm> /* std::max(), std::min() */
 #include <assert.h> /* assert() */
 #include <memory>
+#include <memory_resource>
+#include <span>
+#include <type_traits>
+#include <vector>
 
 namespace ECS
 {
 	class Registry final
 	{
 	public:
-		Registry();
+		/* The entities and every component pool allocate their storage from pResource. Handing every Registry of a level the same arena,
+		   e.g. a std::pmr::monotonic_buffer_resource, turns tearing down the level into releasing that arena.
+		   pResource has to outlive the Registry */
+		explicit Registry(std::pmr::memory_resource* const pResource = std::pmr::get_default_resource());
 		~Registry();
 
 		Registry(const Registry&) noexcept = delete;
@@ -22,41 +33,66 @@ namespace ECS
 		Registry& operator=(const Registry&) noexcept = delete;
 		Registry& operator=(Registry&& other) noexcept;
 
+		/* Ts can contain Maybe<T>, Exclude<Ts...>, Changed<T> and Added<T> filters next to the components, see ViewFilters.h.
+		   Changed and Added only let through components that were stamped after sinceTick, see AdvanceTick() */
 		template<typename ... Ts>
-		[[nodiscard]] View<Ts...> CreateView() const
+		[[nodiscard]] View<Ts...> CreateView(const Tick sinceTick = 0) const
 		{
-			/* Get all components asked for by the user */
-			std::tuple<ComponentArray<Ts>&...> comps
-			{
-				(*static_cast<ComponentArray<Ts>*>(GetComponentArray(ECS::GenerateComponentID<Ts>()).get()))...
-			};
+			return View<Ts...>([this]<typename T>(const std::type_identity<T>&)->ComponentArray<T>*
+				{
+					return FindComponentArray<T>();
+				}, Signatures, sinceTick, GetThreadPool());
+		}
 
-			return View<Ts...>(std::move(comps), Entities);
+		/* The group owns the pools of Ts, so no other group may own any of Ts. See FindOrCreateGroup() */
+		template<typename ... Ts>
+		Group<Ts...>& CreateGroup()
+		{
+			return FindOrCreateGroup<Group, Ts...>();
+		}
+
+		/* A cached group does not own its pools, so it can overlap with any other group. See FindOrCreateGroup() */
+		template<typename ... Ts>
+		CachedGroup<Ts...>& CreateCachedGroup()
+		{
+			return FindOrCreateGroup<CachedGroup, Ts...>(pMemoryResource);
 		}
 
 		template<typename T>
-		T& AddComponent(const Entity entity)
+		ComponentReference<T> AddComponent(const Entity entity)
 		{
-			std::unique_ptr<IComponentArray>& pool{ GetComponentArray(ECS::GenerateComponentID<T>()) };
+			ComponentArray<T>& pool{ GetOrCreateComponentArray<T>() };
 
-			if (!pool)
+			ComponentReference<T> component{ pool.AddComponent(entity) };
+
+			AddToSignature<T>(entity);
+
+			if (Groups.empty())
 			{
-				pool.reset(new ComponentArray<T>{});
+				return component;
 			}
 
-			return static_cast<ComponentArray<T>*>(pool.get())->AddComponent(entity);
+			OnComponentAdded(ECS::GenerateComponentID<T>(), entity);
+
+			return pool.GetComponent(entity); /* A group might have moved the component */
 		}
 		template<typename T, typename ... Ts>
-		T& AddComponent(const Entity entity, Ts&& ... args)
+		ComponentReference<T> AddComponent(const Entity entity, Ts&& ... args)
 		{
-			std::unique_ptr<IComponentArray>& pool{ GetComponentArray(ECS::GenerateComponentID<T>()) };
+			ComponentArray<T>& pool{ GetOrCreateComponentArray<T>() };
 
-			if (!pool)
+			ComponentReference<T> component{ pool.template AddComponent<Ts...>(entity, std::forward<Ts>(args)...) };
+
+			AddToSignature<T>(entity);
+
+			if (Groups.empty())
 			{
-				pool.reset(new ComponentArray<T>{});
+				return component;
 			}
 
-			return static_cast<ComponentArray<T>*>(pool.get())->AddComponent<Ts...>(entity, std::forward<Ts>(args)...);
+			OnComponentAdded(ECS::GenerateComponentID<T>(), entity);
+
+			return pool.GetComponent(entity); /* A group might have moved the component */
 		}
 
 		template<typename T>
@@ -64,23 +100,50 @@ namespace ECS
 		{
 			assert(HasEntity(entity));
 
+			if (!HasComponent<T>(entity))
+			{
+				return;
+			}
+
+			OnComponentRemoved(ECS::GenerateComponentID<T>(), entity);
+
 			GetComponentArray(ECS::GenerateComponentID<T>())->Remove(entity);
+			Signatures[GetEntityIndex(entity)].reset(ECS::GenerateComponentID<T>());
 		}
 
 		template<typename T>
 		[[nodiscard]] bool HasComponent(const Entity entity) const
 		{
-			return static_cast<ComponentArray<T>*>(GetComponentArray(ECS::GenerateComponentID<T>()).get())->HasEntity(entity);
+			return HasEntity(entity) && Signatures[GetEntityIndex(entity)].test(ECS::GenerateComponentID<T>());
+		}
+
+		/* Whether entity has every one of Ts, a single masked compare of its signature */
+		template<typename ... Ts>
+		[[nodiscard]] bool HasComponents(const Entity entity) const
+		{
+			EntitySignature signature{};
+			(signature.set(ECS::GenerateComponentID<Ts>()), ...);
+
+			return HasEntity(entity) && (Signatures[GetEntityIndex(entity)] & signature) == signature;
+		}
+
+		/* Every component type entity has, by ComponentType */
+		[[nodiscard]] const EntitySignature& GetSignature(const Entity entity) const
+		{
+			assert(HasEntity(entity));
+			return Signatures[GetEntityIndex(entity)];
 		}
 
+		/* Stamps the component as modified at the current tick, use the const version to only read it */
 		template<typename T>
-		[[nodiscard]] T& GetComponent(const Entity entity)
+		[[nodiscard]] ComponentReference<T> GetComponent(const Entity entity)
 		{
 			assert(GetComponentArray(ECS::GenerateComponentID<T>()));
-			return static_cast<ComponentArray<T>*>(GetComponentArray(ECS::GenerateComponentID<T>()).get())->GetComponent(entity);
+
+			return static_cast<ComponentArray<T>*>(GetComponentArray(ECS::GenerateComponentID<T>()).get())->ModifyComponent(entity);
 		}
 		template<typename T>
-		[[nodiscard]] const T& GetComponent(const Entity entity) const
+		[[nodiscard]] ComponentReference<const T> GetComponent(const Entity entity) const
 		{
 			assert(GetComponentArray(ECS::GenerateComponentID<T>()));
 			return static_cast<ComponentArray<T>*>(GetComponentArray(ECS::GenerateComponentID<T>()).get())->GetComponent(entity);
@@ -93,33 +156,315 @@ namespace ECS
 			return static_cast<ComponentArray<T>*>(GetComponentArray(ECS::GenerateComponentID<T>()).get())->FindEntity(comp);
 		}
 
+		/* Makes room for entities in total, creating and releasing up to that many entities does not allocate */
+		void Reserve(const size_t entities);
+
+		/* Makes room for count components of T. Which entities will get them is not known, so the sparse pages of the pool are
+		   still allocated once an entity in them is added, use the overload with firstEntity to allocate those up front as well */
+		template<typename T>
+		void Reserve(const size_t count)
+		{
+			GetOrCreateComponentArray<T>().Reserve(count);
+		}
+		/* Makes room for count components of T for the count entities with consecutive indices starting at the index of firstEntity,
+		   adding T to those entities afterwards does not allocate */
+		template<typename T>
+		void Reserve(const size_t count, const Entity firstEntity)
+		{
+			ComponentArray<T>& pool{ GetOrCreateComponentArray<T>() };
+
+			pool.Reserve(count);
+			pool.ReserveIndices(GetEntityIndex(firstEntity), count);
+		}
+
+		template<typename T>
+		[[nodiscard]] size_t GetCapacity() const
+		{
+			return CanViewBeCreated<T>() ? static_cast<ComponentArray<T>*>(GetComponentArray(ECS::GenerateComponentID<T>()).get())->Capacity() : 0;
+		}
+
+		/* Releases the memory the pool of T does not need for its current components */
+		template<typename T>
+		void ShrinkToFit()
+		{
+			if (CanViewBeCreated<T>())
+			{
+				GetComponentArray(ECS::GenerateComponentID<T>())->ShrinkToFit();
+			}
+		}
+
+		/* Releases the memory the entities and every pool do not need right now */
+		void ShrinkToFit();
+
+		/* Sorts the pool of T so that Views visit its entities in the order of compare(const T&, const T&).
+		   T must not be owned by a Group */
+		template<typename T, typename Compare>
+		void Sort(Compare compare)
+		{
+			assert(!IsOwnedByGroup(ECS::GenerateComponentID<T>()) && "Registry::Sort() > The pool is owned by a group, which decides its order");
+
+			if (ComponentArray<T>* const pPool{ FindComponentArray<T>() })
+			{
+				pPool->Sort(std::move(compare));
+			}
+		}
+
+		/* Sorts the pool of T so that the entities it shares with the pool of U come in the same order as in U.
+		   A View over both then reads both pools in sequence. T must not be owned by a Group */
+		template<typename T, typename U>
+		void Sort()
+		{
+			assert(!IsOwnedByGroup(ECS::GenerateComponentID<T>()) && "Registry::Sort() > The pool is owned by a group, which decides its order");
+
+			ComponentArray<T>* const pPool{ FindComponentArray<T>() };
+			const ComponentArray<U>* const pOther{ FindComponentArray<U>() };
+
+			if (pPool && pOther)
+			{
+				pPool->SortAs(*pOther);
+			}
+		}
+
 		[[nodiscard]] Entity CreateEntity();
+
+		/* Creates an entity that already has every one of Ts, each pool is only looked up once.
+		   Either no components are passed and every one of Ts is default constructed, or the i-th component is constructed from the i-th argument */
+		template<typename ... Ts, typename ... Args>
+		[[nodiscard]] Entity CreateEntity(Args&& ... components)
+		{
+			static_assert(sizeof ... (Ts) > 0, "Registry::CreateEntity<Ts...>() > Use CreateEntity() for an entity without components");
+			static_assert(sizeof ... (Args) == 0 || sizeof ... (Args) == sizeof ... (Ts), "Registry::CreateEntity<Ts...>() > Pass either no components or one per type");
+
+			const Entity entity{ CreateEntity() };
+
+			if constexpr (sizeof ... (Args) == 0)
+			{
+				(GetOrCreateComponentArray<Ts>().AddComponent(entity), ...);
+			}
+			else
+			{
+				(GetOrCreateComponentArray<Ts>().AddComponent(entity, std::forward<Args>(components)), ...);
+			}
+
+			AddToSignature<Ts...>(entity);
+
+			if (!Groups.empty())
+			{
+				(OnComponentAdded(ECS::GenerateComponentID<Ts>(), entity), ...);
+			}
+
+			return entity;
+		}
+
+		/* Creates count entities that each get a default constructed component of every one of Ts and writes them to output.
+		   The entities and every pool are reserved up front, so the whole batch is a single pass without reallocations */
+		template<typename ... Ts, typename OutputIt>
+		OutputIt CreateEntities(const size_t count, OutputIt output)
+		{
+			/* Recycled entities already have a signature and a sparse page, only the indices that are new to the registry need them */
+			const size_t nrOfNewIndices{ count > RecycledEntities.size() ? count - RecycledEntities.size() : 0 };
+
+			ReserveAdditional(Entities, count);
+			Entities.AllocatePages(CurrentEntityCounter, nrOfNewIndices);
+			const size_t requiredSignatures{ static_cast<size_t>(CurrentEntityCounter) + nrOfNewIndices };
+
+			if (requiredSignatures > Signatures.capacity())
+			{
+				Signatures.reserve(std::max(requiredSignatures, Signatures.capacity() * 2));
+			}
+
+			std::tuple<ComponentArray<Ts>&...> pools
+			{
+				GetOrCreateComponentArray<Ts>()...
+			};
+
+			(ReserveAdditional(std::get<ComponentArray<Ts>&>(pools), count), ...);
+			(ReserveNextIndices(std::get<ComponentArray<Ts>&>(pools), count), ...);
+
+			for (size_t i{}; i < count; ++i)
+			{
+				const Entity entity{ CreateEntity() };
+
+				(std::get<ComponentArray<Ts>&>(pools).AddComponent(entity), ...);
+
+				AddToSignature<Ts...>(entity);
+
+				if (!Groups.empty())
+				{
+					(OnComponentAdded(ECS::GenerateComponentID<Ts>(), entity), ...);
+				}
+
+				*output++ = entity;
+			}
+
+			return output;
+		}
 		[[nodiscard]] size_t GetAmountOfEntities() const { return Entities.Size(); }
 		[[nodiscard]] bool HasEntity(const Entity entity) const;
 		bool ReleaseEntity(const Entity entity);
+		/* Releases every entity in entities at once, each pool is visited a single time for the whole batch.
+		   Returns how many entities were released, entities that are not alive are skipped */
+		size_t ReleaseEntities(const std::span<const Entity> entities);
 
+		/* Only the required components of a View need an existing pool, filters do not */
 		template<typename ... Ts>
 		[[nodiscard]] bool CanViewBeCreated() const
 		{
-			return ((std::find_if(ComponentPools.cbegin(), ComponentPools.cend(), [](const auto& cPool)->bool
-				{
-					return ECS::GenerateComponentID<Ts>() == cPool.first;
-				}) != ComponentPools.cend()) && ...);
+			return (HasViewElementPool<Ts>() && ...);
 		}
 
 		void Clear();
 
+		/* Components are stamped with the current tick when they are added or handed out mutably.
+		   A system that only wants what changed since its previous run passes the tick AdvanceTick() returned after that run
+		   to CreateView() and filters on Changed<T> or Added<T>. What the system changes itself is then not reported back to it */
+		[[nodiscard]] Tick GetCurrentTick() const { return CurrentTick; }
+		/* Starts a new tick and returns the one that ended. Must not be called while components are being accessed on other threads */
+		Tick AdvanceTick();
+
+		/* Views run their ForEachParallel() on this pool. Without one set, the shared ThreadPool instance is used */
+		void SetThreadPool(ThreadPool* const pPool) { pThreadPool = pPool; }
+
+		[[nodiscard]] std::pmr::memory_resource* GetMemoryResource() const { return pMemoryResource; }
+		[[nodiscard]] ThreadPool& GetThreadPool() const { return pThreadPool ? *pThreadPool : ThreadPool::GetInstance(); }
+
 	private:
+		/* Makes room for count more elements, growing at least geometrically so many small batches in a row stay amortised */
+		template<typename Container>
+		static void ReserveAdditional(Container& container, const size_t count)
+		{
+			const size_t required{ container.Size() + count };
+
+			if (required > container.Capacity())
+			{
+				container.Reserve(std::max(required, container.Capacity() * 2));
+			}
+		}
+
+		/* Allocates the sparse pages of pool for the indices the next count calls to CreateEntity() hand out,
+		   the recycled indices first and then the ones that are new to the registry */
+		template<typename T>
+		void ReserveNextIndices(ComponentArray<T>& pool, const size_t count) const
+		{
+			const size_t nrOfRecycled{ std::min(count, RecycledEntities.size()) };
+
+			for (size_t i{ RecycledEntities.size() - nrOfRecycled }; i < RecycledEntities.size(); ++i)
+			{
+				pool.ReserveIndices(GetEntityIndex(RecycledEntities[i]), 1);
+			}
+
+			pool.ReserveIndices(CurrentEntityCounter, count - nrOfRecycled);
+		}
+
+		/* Creates the group the first time it is asked for, later calls return the same group.
+		   The group gets the pools of Ts followed by args. A const T is only read by the group */
+		template<template<typename...> typename GroupType, typename ... Ts, typename ... Args>
+		GroupType<Ts...>& FindOrCreateGroup(Args&& ... args)
+		{
+			[[maybe_unused]] constexpr bool isOwning{ std::is_same_v<GroupType<Ts...>, Group<Ts...>> };
+
+			for (const std::unique_ptr<IGroup>& pGroup : Groups)
+			{
+				if (GroupType<Ts...>* const pExistingGroup{ dynamic_cast<GroupType<Ts...>*>(pGroup.get()) })
+				{
+					return *pExistingGroup;
+				}
+
+				assert(!(isOwning && (pGroup->Owns(ECS::GenerateComponentID<Ts>()) || ...)) && "Registry::CreateGroup() > A component can only be owned by one group");
+			}
+
+			std::tuple<GroupPoolType<Ts>&...> comps
+			{
+				GetOrCreateComponentArray<std::remove_const_t<Ts>>()...
+			};
+
+			return static_cast<GroupType<Ts...>&>(*Groups.emplace_back(std::make_unique<GroupType<Ts...>>(std::move(comps), std::forward<Args>(args)...)));
+		}
+
+		template<typename ... Ts>
+		void AddToSignature(const Entity entity)
+		{
+			EntitySignature& signature{ Signatures[GetEntityIndex(entity)] };
+			(signature.set(ECS::GenerateComponentID<Ts>()), ...);
+		}
+
+		/* Calls function(cType) for every component type in signature, stops after the last one that is set */
+		template<typename Function>
+		static void ForEachComponentType(const EntitySignature& signature, Function&& function)
+		{
+			for (size_t cType{}, remaining{ signature.count() }; remaining > 0; ++cType)
+			{
+				if (signature.test(cType))
+				{
+					function(cType);
+					--remaining;
+				}
+			}
+		}
+
+		[[nodiscard]] bool IsOwnedByGroup(const ComponentType cType) const;
 		void RemoveAllComponents(const Entity entity);
+		void RecycleEntity(const Entity entity);
+		void OnComponentAdded(const ComponentType cType, const Entity entity);
+		void OnComponentRemoved(const ComponentType cType, const Entity entity);
+
+		template<typename T>
+		[[nodiscard]] bool HasViewElementPool() const
+		{
+			if constexpr (ViewElementTraits<T>::IsRequired)
+			{
+				return FindComponentArray<typename ViewElementTraits<T>::Component>() != nullptr;
+			}
+			else
+			{
+				return true;
+			}
+		}
+
+		/* nullptr if no component of T has been added yet */
+		template<typename T>
+		[[nodiscard]] ComponentArray<T>* FindComponentArray() const
+		{
+			const ComponentType cType{ ECS::GenerateComponentID<T>() };
+
+			return cType < ComponentPools.size() ? static_cast<ComponentArray<T>*>(ComponentPools[cType].get()) : nullptr;
+		}
+
+		template<typename T>
+		[[nodiscard]] ComponentArray<T>& GetOrCreateComponentArray()
+		{
+			std::unique_ptr<IComponentArray>& pool{ GetComponentArray(ECS::GenerateComponentID<T>()) };
+
+			if (!pool)
+			{
+				pool.reset(new ComponentArray<T>{ pMemoryResource });
+				pool->SetCurrentTick(CurrentTick);
+			}
+
+			return *static_cast<ComponentArray<T>*>(pool.get());
+		}
+
 		[[nodiscard]] std::unique_ptr<IComponentArray>& GetComponentArray(const size_t cType);
 		[[nodiscard]] const std::unique_ptr<IComponentArray>& GetComponentArray(const size_t cType) const;
 
 		// Entities
 		SparseSet<Entity> Entities;
-		std::vector<Entity> RecycledEntities;
+		std::pmr::vector<Entity> RecycledEntities;
+		std::pmr::vector<EntitySignature> Signatures; /* Indexed by entity index */
 		Entity CurrentEntityCounter;
 
 		// Components
-		std::vector<std::pair<size_t, std::unique_ptr<IComponentArray>>> ComponentPools; // [TODO]: Make a map that uses arrays 
+		std::vector<std::unique_ptr<IComponentArray>> ComponentPools; /* Indexed by ComponentType */
+		std::pmr::vector<std::pmr::vector<Entity>> ReleasedPerPool; /* Scratch of ReleaseEntities(), indexed by ComponentType */
+		Tick CurrentTick; /* Starts at 1, so a View for tick 0 sees every component */
+
+		// Groups
+		std::vector<std::unique_ptr<IGroup>> Groups;
+
+		// Threading
+		ThreadPool* pThreadPool;
+
+		// Memory
+		std::pmr::memory_resource* pMemoryResource;
 	};
 }
\ No newline at end of file
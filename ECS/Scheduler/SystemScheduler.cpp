@@ -0,0 +1,107 @@
+#include "SystemScheduler.h"
+
+namespace ECS
+{
+	SystemScheduler::SystemScheduler(Registry& registry)
+		: m_pRegistry{ &registry }
+		, m_Systems{}
+		, m_RemainingDependencies{}
+		, m_IsGraphDirty{}
+	{}
+
+	void SystemScheduler::Update()
+	{
+		if (m_IsGraphDirty)
+		{
+			BuildDependencyGraph();
+		}
+
+		if (m_Systems.empty())
+		{
+			return;
+		}
+
+		ThreadPool& threadPool{ m_pRegistry->GetThreadPool() };
+
+		/* Workers notify after their decrement, which may be after this call returned, so the countdown has to outlive it */
+		const std::shared_ptr<std::atomic<size_t>> pNrOfRemainingSystems{ std::make_shared<std::atomic<size_t>>(m_Systems.size()) };
+
+		for (size_t i{}; i < m_Systems.size(); ++i)
+		{
+			m_RemainingDependencies[i] = m_Systems[i].NrOfDependencies;
+		}
+
+		for (size_t i{}; i < m_Systems.size(); ++i)
+		{
+			if (m_Systems[i].NrOfDependencies == 0)
+			{
+				threadPool.Submit([this, i, pNrOfRemainingSystems]()->void
+					{
+						RunSystem(i, pNrOfRemainingSystems);
+					});
+			}
+		}
+
+		size_t nrOfRemainingSystems{ pNrOfRemainingSystems->load() };
+
+		while (nrOfRemainingSystems != 0)
+		{
+			if (!threadPool.RunPendingTask())
+			{
+				pNrOfRemainingSystems->wait(nrOfRemainingSystems);
+			}
+
+			nrOfRemainingSystems = pNrOfRemainingSystems->load();
+		}
+	}
+
+	void SystemScheduler::BuildDependencyGraph()
+	{
+		for (size_t i{}; i < m_Systems.size(); ++i)
+		{
+			System& system{ m_Systems[i] };
+
+			system.Dependents.clear();
+			system.NrOfDependencies = 0;
+
+			for (size_t j{}; j < i; ++j)
+			{
+				System& previousSystem{ m_Systems[j] };
+
+				const bool areConflicting{ (system.Writes & (previousSystem.Reads | previousSystem.Writes)).any()
+					|| (previousSystem.Writes & system.Reads).any() };
+
+				if (areConflicting)
+				{
+					previousSystem.Dependents.push_back(i);
+					++system.NrOfDependencies;
+				}
+			}
+		}
+
+		m_RemainingDependencies.reset(new std::atomic<size_t>[m_Systems.size()]{});
+		m_IsGraphDirty = false;
+	}
+
+	void SystemScheduler::RunSystem(const size_t index, const std::shared_ptr<std::atomic<size_t>>& pNrOfRemainingSystems)
+	{
+		const System& system{ m_Systems[index] };
+
+		system.Update();
+
+		/* Dependents that are now free to run go to this worker's own queue, idle workers steal them from there */
+		for (const size_t dependent : system.Dependents)
+		{
+			if (--m_RemainingDependencies[dependent] == 0)
+			{
+				m_pRegistry->GetThreadPool().Submit([this, dependent, pNrOfRemainingSystems]()->void
+					{
+						RunSystem(dependent, pNrOfRemainingSystems);
+					});
+			}
+		}
+
+		--*pNrOfRemainingSystems;
+		pNrOfRemainingSystems->notify_all();
+	}
+}
\ No newline at end of file
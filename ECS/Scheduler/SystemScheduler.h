@@ -0,0 +1,86 @@
+#pragma once
+
+#include "../ECSConstants.h"
+#include "../ComponentIDGenerator/ComponentIDGenerator.h"
+#include "../Registry/Registry.h"
+#include "../View/ViewFilters.h"
+
+#include <atomic> /* std::atomic */
+#include <functional> /* std::function */
+#include <memory> /* std::unique_ptr, std::shared_ptr */
+#include <utility> /* std::forward() */
+#include <vector> /* std::vector */
+
+namespace ECS
+{
+	/* Runs the systems of a Registry on its ThreadPool.
+	   Systems declare their access through their component types: a const T is only read, a T is written.
+	   Two systems conflict when one of them writes a component the other one reads or writes. Conflicting systems run in the order
+	   they were added in, all other systems may run at the same time */
+	class SystemScheduler final
+	{
+	public:
+		explicit SystemScheduler(Registry& registry);
+
+		SystemScheduler(const SystemScheduler&) noexcept = delete;
+		SystemScheduler(SystemScheduler&&) noexcept = delete;
+		SystemScheduler& operator=(const SystemScheduler&) noexcept = delete;
+		SystemScheduler& operator=(SystemScheduler&&) noexcept = delete;
+
+		/* Function is called the same way as by View<Ts...>::ForEach(), so Ts can contain Maybe and Exclude filters too.
+		   Excluded components are only checked for, which does not count as an access.
+		   Changed and Added filters need the tick a system last ran at, which is not tracked per system, so they are not supported */
+		template<typename ... Ts, typename Function>
+		void AddSystem(Function&& function)
+		{
+			static_assert(((ViewElementTraits<Ts>::TickFilter == ViewTickFilter::None) && ...), "SystemScheduler::AddSystem() does not support Changed or Added");
+
+			System system{};
+
+			system.Update = [pRegistry = m_pRegistry, function = std::forward<Function>(function)]() mutable->void
+			{
+				if (pRegistry->CanViewBeCreated<Ts...>())
+				{
+					pRegistry->CreateView<Ts...>().ForEach(function);
+				}
+			};
+
+			(AddAccess<Ts>(system), ...);
+
+			m_Systems.push_back(std::move(system));
+			m_IsGraphDirty = true;
+		}
+
+		/* Runs every system once and blocks until all of them are done. The calling thread helps out */
+		void Update();
+
+		[[nodiscard]] size_t GetAmountOfSystems() const { return m_Systems.size(); }
+
+	private:
+		struct System final
+		{
+			std::function<void()> Update;
+			EntitySignature Reads;
+			EntitySignature Writes;
+			std::vector<size_t> Dependents;
+			size_t NrOfDependencies;
+		};
+
+		template<typename T>
+		static void AddAccess(System& system)
+		{
+			if constexpr (ViewElementTraits<T>::IsArgument)
+			{
+				(ViewElementTraits<T>::IsReadOnly ? system.Reads : system.Writes).set(GenerateComponentID<typename ViewElementTraits<T>::Component>());
+			}
+		}
+
+		void BuildDependencyGraph();
+		void RunSystem(const size_t index, const std::shared_ptr<std::atomic<size_t>>& pNrOfRemainingSystems);
+
+		Registry* m_pRegistry;
+		std::vector<System> m_Systems;
+		std::unique_ptr<std::atomic<size_t>[]> m_RemainingDependencies;
+		bool m_IsGraphDirty;
+	};
+}
\ No newline at end of file
@@ -1,7 +1,11 @@
 #pragma once
 
+#include "../ECSConstants.h"
+#include "PagedSparseArray.h"
+
 #include <assert.h> 
-#include <vector> 
+#include <memory_resource> /* std::pmr::memory_resource, std::pmr::vector */
+#include <utility> 
 
 namespace ECS
 {
@@ -9,9 +13,10 @@ namespace ECS
 	class DenseSet final
 	{
 	public:
-		DenseSet()
-			: Sparse{}
-			, Packed{}
+		/* Both the sparse pages and the packed pairs are allocated from pResource */
+		explicit DenseSet(std::pmr::memory_resource* const pResource = std::pmr::get_default_resource())
+			: Sparse{ pResource }
+			, Packed{ pResource }
 			, _Size{}
 		{
 			static_assert(std::is_integral_v<T>, "SparseSet only supports integer types");
@@ -26,36 +31,48 @@ namespace ECS
 				return false;
 			}
 
-			if (Packed.size() <= _Size)
-			{
-				Packed.resize(_Size + 1);
-			}
-			if (Sparse.size() <= valOne)
-			{
-				Sparse.resize(valOne + 1, InvalidEntityID);
-			}
+			const Entity index{ GetEntityIndex(static_cast<Entity>(valOne)) };
 
-			Packed[_Size] = std::make_pair(valOne, valTwo);
-			Sparse[valOne] = _Size++;
+			Entity& sparse{ Sparse.Assure(index) };
+
+			assert(sparse == InvalidEntityID && "An older version of this value is still in the set");
+
+			sparse = CreateEntityID(static_cast<Entity>(_Size++), GetEntityVersion(static_cast<Entity>(valOne)));
+			Packed.emplace_back(std::forward<U>(valOne), std::forward<V>(valTwo));
 
 			return true;
 		}
 
 		bool Contains(const T value) const
 		{
-			return (value < Sparse.size()) && (Sparse[value] != InvalidEntityID);
+			return Sparse.Contains(static_cast<Entity>(value));
 		}
 
 		size_t Size() const { return _Size; }
-		void Clear() { Sparse.clear(); Packed.clear(); _Size = 0; }
+		void Clear() { Sparse.Clear(); Packed.clear(); _Size = 0; }
 
+		/* Makes room for capacity pairs and the page table of the indices below capacity, the sparse pages are left to AllocatePages() */
+		void Reserve(const size_t capacity) { Sparse.Reserve(capacity); Packed.reserve(capacity); }
+		/* Allocates the sparse pages of the count indices starting at firstIndex, so adding values with those indices does not allocate them */
+		void AllocatePages(const Entity firstIndex, const size_t count) { Sparse.AllocatePages(firstIndex, count); }
+		size_t Capacity() const { return Packed.capacity(); }
+		void ShrinkToFit() { Sparse.ShrinkToFit(); Packed.shrink_to_fit(); }
+
+		/* Swap-and-pop: the last value is moved into the freed slot and the packed array shrinks.
+		   The second value belongs to the slot, not to the key, so it is expected to index an array that is compacted the same way */
 		bool Remove(const T value)
 		{
 			if (Contains(value))
 			{
-				--_Size;
+				const Entity index{ GetPackedIndex(value) };
+				const T last{ Packed.back().first };
 
-				Sparse[value] = InvalidEntityID;
+				Packed[index].first = last;
+				Sparse[GetEntityIndex(static_cast<Entity>(last))] = CreateEntityID(index, GetEntityVersion(static_cast<Entity>(last)));
+
+				Sparse[GetEntityIndex(static_cast<Entity>(value))] = InvalidEntityID;
+				Packed.pop_back();
+				--_Size;
 
 				return true;
 			}
@@ -63,12 +80,27 @@ namespace ECS
 			return false;
 		}
 
-		__forceinline T GetFirst(const T val) const { assert(Contains(val)); return Packed[Sparse[val]].first; }
-		__forceinline T GetSecond(const T val) const { assert(Contains(val)); return Packed[Sparse[val]].second; }
+		/* Swaps the values in two packed slots, the second values stay with their slot */
+		void SwapAt(const size_t first, const size_t second)
+		{
+			assert(first < _Size && second < _Size);
+
+			std::swap(Packed[first].first, Packed[second].first);
+
+			Sparse[GetEntityIndex(static_cast<Entity>(Packed[first].first))] = CreateEntityID(static_cast<Entity>(first), GetEntityVersion(static_cast<Entity>(Packed[first].first)));
+			Sparse[GetEntityIndex(static_cast<Entity>(Packed[second].first))] = CreateEntityID(static_cast<Entity>(second), GetEntityVersion(static_cast<Entity>(Packed[second].first)));
+		}
+
+		__forceinline T GetFirst(const T val) const { assert(Contains(val)); return Packed[GetPackedIndex(val)].first; }
+		__forceinline T GetSecond(const T val) const { assert(Contains(val)); return Packed[GetPackedIndex(val)].second; }
+
+		__forceinline T GetFirstAt(const size_t index) const { assert(index < _Size); return Packed[index].first; }
 
 	private:
-		std::vector<T> Sparse;
-		std::vector<std::pair<T, T>> Packed;
+		__forceinline Entity GetPackedIndex(const T val) const { return GetEntityIndex(Sparse[GetEntityIndex(static_cast<Entity>(val))]); }
+
+		PagedSparseArray Sparse;
+		std::pmr::vector<std::pair<T, T>> Packed;
 		T _Size;
 	};
 }
\ No newline at end of file
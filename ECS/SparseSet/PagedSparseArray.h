@@ -0,0 +1,151 @@
+#pragma once
+
+#include "../ECSConstants.h"
+#include "../Utils/PageList.h"
+
+#include <algorithm> /* std::fill_n(), std::copy_n(), std::all_of() */
+#include <assert.h> /* assert() */
+#include <memory_resource> /* std::pmr::memory_resource */
+
+namespace ECS
+{
+	/* Sparse side of SparseSet and DenseSet, split into fixed-size pages that are only allocated once an index in them is used.
+	   Growing never copies existing pages and untouched ranges of indices cost a single null pointer.
+	   The pages and the page table come from pResource */
+	class PagedSparseArray final
+	{
+	public:
+		explicit PagedSparseArray(std::pmr::memory_resource* const pResource = std::pmr::get_default_resource())
+			: Pages{ pResource }
+		{}
+		~PagedSparseArray() = default;
+
+		PagedSparseArray(const PagedSparseArray&) noexcept = delete;
+		PagedSparseArray(PagedSparseArray&&) noexcept = default;
+		PagedSparseArray& operator=(const PagedSparseArray&) noexcept = delete;
+		PagedSparseArray& operator=(PagedSparseArray&& other) noexcept
+		{
+			if (this == &other)
+			{
+				return *this;
+			}
+
+			if (Pages.TakePages(other.Pages))
+			{
+				return *this;
+			}
+
+			for (size_t page{}; page < other.Pages.Size(); ++page)
+			{
+				if (other.Pages[page])
+				{
+					Entity* const pPage{ &Assure(static_cast<Entity>(page * SparsePageSize)) };
+					std::copy_n(other.Pages[page], SparsePageSize, pPage);
+				}
+			}
+
+			other.Clear();
+
+			return *this;
+		}
+
+		[[nodiscard]] __forceinline Entity Get(const Entity index) const
+		{
+			const size_t page{ index / SparsePageSize };
+
+			return (page < Pages.Size() && Pages[page]) ? Pages[page][index % SparsePageSize] : InvalidEntityID;
+		}
+
+		/* Every used slot stores a packed index together with the version of its value, so whether value is in the set is a single compare.
+		   An empty slot has the all-ones version, so it is rejected first or any handle with that version would match it */
+		[[nodiscard]] __forceinline bool Contains(const Entity value) const
+		{
+			const Entity slot{ Get(GetEntityIndex(value)) };
+
+			return slot != InvalidEntityID && ((slot ^ value) & EntityVersionMask) == 0;
+		}
+
+		[[nodiscard]] __forceinline Entity& operator[](const Entity index)
+		{
+			assert(Pages[index / SparsePageSize]);
+			return Pages[index / SparsePageSize][index % SparsePageSize];
+		}
+		[[nodiscard]] __forceinline Entity operator[](const Entity index) const
+		{
+			assert(Pages[index / SparsePageSize]);
+			return Pages[index / SparsePageSize][index % SparsePageSize];
+		}
+
+		/* Allocates the page holding index if it does not exist yet and returns its slot */
+		Entity& Assure(const Entity index)
+		{
+			const size_t page{ index / SparsePageSize };
+
+			if (page >= Pages.Size() || !Pages[page])
+			{
+				std::fill_n(Pages.AllocatePage(page), SparsePageSize, InvalidEntityID);
+			}
+
+			return Pages[page][index % SparsePageSize];
+		}
+
+		/* Makes room in the page table for the indices below capacity. Pages are still only allocated once an index in them is used,
+		   a set's capacity says nothing about which indices it will hold */
+		void Reserve(const size_t capacity)
+		{
+			Pages.Reserve((capacity + SparsePageSize - 1) / SparsePageSize);
+		}
+
+		/* Allocates every page holding one of the count indices starting at firstIndex, so using those indices later does not allocate */
+		void AllocatePages(const size_t firstIndex, const size_t count)
+		{
+			if (count == 0)
+			{
+				return;
+			}
+
+			const size_t lastPage{ (firstIndex + count - 1) / SparsePageSize };
+
+			Pages.Reserve(lastPage + 1);
+
+			for (size_t page{ firstIndex / SparsePageSize }; page <= lastPage; ++page)
+			{
+				Assure(static_cast<Entity>(page * SparsePageSize));
+			}
+		}
+
+		/* Releases every page that has no used slot left */
+		void ShrinkToFit()
+		{
+			size_t nrOfPages{};
+
+			for (size_t page{}; page < Pages.Size(); ++page)
+			{
+				if (const Entity* const pPage{ Pages[page] })
+				{
+					if (std::all_of(pPage, pPage + SparsePageSize, [](const Entity slot)->bool { return slot == InvalidEntityID; }))
+					{
+						Pages.ReleasePage(page);
+					}
+					else
+					{
+						nrOfPages = page + 1;
+					}
+				}
+			}
+
+			Pages.ReleasePages(nrOfPages);
+			Pages.ShrinkToFit();
+		}
+
+		void Clear()
+		{
+			Pages.ReleasePages(0);
+		}
+
+		[[nodiscard]] std::pmr::memory_resource* GetResource() const { return Pages.GetResource(); }
+
+	private:
+		PageList<Entity, SparsePageSize> Pages;
+	};
+}
\ No newline at end of file
@@ -1,7 +1,10 @@
 #pragma once
 
+#include "../ECSConstants.h"
+#include "PagedSparseArray.h"
+
 #include <assert.h> 
-#include <vector> 
+#include <memory_resource> /* std::pmr::memory_resource, std::pmr::vector */
 
 namespace ECS
 {
@@ -9,13 +12,14 @@ namespace ECS
 	class SparseSet final
 	{
 	private:
-		using VectorIt = std::vector<T>::iterator;
-		using VectorCIt = std::vector<T>::const_iterator;
+		using VectorIt = std::pmr::vector<T>::iterator;
+		using VectorCIt = std::pmr::vector<T>::const_iterator;
 
 	public:
-		SparseSet()
-			: Sparse{}
-			, Packed{}
+		/* Both the sparse pages and the packed values are allocated from pResource */
+		explicit SparseSet(std::pmr::memory_resource* const pResource = std::pmr::get_default_resource())
+			: Sparse{ pResource }
+			, Packed{ pResource }
 			, _Size{}
 		{
 			static_assert(std::is_integral_v<T>, "SparseSet only supports integer types");
@@ -34,34 +38,26 @@ namespace ECS
 
 		bool Contains(const T value) const
 		{
-			return (value < Sparse.size()) && (Sparse[value] != InvalidEntityID);
-		}
-
-		T GetSparse(const T value) const
-		{
-			for (const T sparse : Sparse)
-			{
-				if (sparse != InvalidEntityID && sparse == value)
-				{
-					return sparse;
-				}
-			}
-
-			assert(false);
-
-			return static_cast<T>(0);
+			return Sparse.Contains(static_cast<Entity>(value));
 		}
 
 		size_t Size() const { return _Size; }
-		void Clear() { Sparse.clear(); Packed.clear(); _Size = 0; }
+		void Clear() { Sparse.Clear(); Packed.clear(); _Size = 0; }
 
+		/* Swap-and-pop: the last value is moved into the freed slot so Packed only ever holds live values */
 		bool Remove(const T value)
 		{
 			if (Contains(value))
 			{
-				--_Size;
+				const Entity index{ GetEntityIndex(Sparse[GetEntityIndex(static_cast<Entity>(value))]) };
+				const T last{ Packed.back() };
+
+				Packed[index] = last;
+				Sparse[GetEntityIndex(static_cast<Entity>(last))] = CreateEntityID(index, GetEntityVersion(static_cast<Entity>(last)));
 
-				Sparse[value] = InvalidEntityID;
+				Sparse[GetEntityIndex(static_cast<Entity>(value))] = InvalidEntityID;
+				Packed.pop_back();
+				--_Size;
 
 				return true;
 			}
@@ -69,17 +65,28 @@ namespace ECS
 			return false;
 		}
 
-		void Reserve(const size_t capacity) { Sparse.reserve(capacity); Packed.reserve(capacity); }
+		/* Makes room for capacity values and the page table of the indices below capacity, the sparse pages are left to AllocatePages() */
+		void Reserve(const size_t capacity) { Sparse.Reserve(capacity); Packed.reserve(capacity); }
+		/* Allocates the sparse pages of the count indices starting at firstIndex, so adding values with those indices does not allocate them */
+		void AllocatePages(const Entity firstIndex, const size_t count) { Sparse.AllocatePages(firstIndex, count); }
+		size_t Capacity() const { return Packed.capacity(); }
+		void ShrinkToFit() { Sparse.ShrinkToFit(); Packed.shrink_to_fit(); }
 
 		[[nodiscard]] __forceinline T & operator[](const T val)
 		{
 			assert(Contains(val));
-			return Packed[Sparse[val]];
+			return Packed[GetEntityIndex(Sparse[GetEntityIndex(static_cast<Entity>(val))])];
 		}
 		[[nodiscard]] __forceinline const T operator[](const T val) const
 		{
 			assert(Contains(val));
-			return Packed[Sparse[val]];
+			return Packed[GetEntityIndex(Sparse[GetEntityIndex(static_cast<Entity>(val))])];
+		}
+
+		[[nodiscard]] __forceinline T GetAt(const size_t index) const
+		{
+			assert(index < _Size);
+			return Packed[index];
 		}
 
 		VectorIt begin() { return Packed.begin(); }
@@ -100,23 +107,20 @@ namespace ECS
 				return false;
 			}
 
-			if (Packed.size() <= _Size)
-			{
-				Packed.resize(_Size + 1);
-			}
-			if (Sparse.size() <= value)
-			{
-				Sparse.resize(value + 1, InvalidEntityID);
-			}
+			const Entity index{ GetEntityIndex(static_cast<Entity>(value)) };
+
+			Entity& sparse{ Sparse.Assure(index) };
+
+			assert(sparse == InvalidEntityID && "An older version of this value is still in the set");
 
-			Packed[_Size] = value;
-			Sparse[value] = _Size++;
+			sparse = CreateEntityID(static_cast<Entity>(_Size++), GetEntityVersion(static_cast<Entity>(value)));
+			Packed.push_back(std::forward<U>(value));
 
 			return true;
 		}
 
-		std::vector<T> Sparse;
-		std::vector<T> Packed;
+		PagedSparseArray Sparse;
+		std::pmr::vector<T> Packed;
 		T _Size;
 	};
 }
\ No newline at end of file
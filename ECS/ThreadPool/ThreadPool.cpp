@@ -0,0 +1,212 @@
+#include "ThreadPool.h"
+
+#include <algorithm> /* std::min(), std::max() */
+#include <assert.h> /* assert() */
+
+namespace ECS
+{
+	ThreadPool::ThreadPool(const size_t nrOfThreads)
+		: m_Queues{}
+		, m_Threads{}
+		, m_NrOfPendingTasks{}
+		, m_NextQueue{}
+		, m_SleepMutex{}
+		, m_ConditionVariable{}
+		, m_IsShuttingDown{}
+	{
+		/* Without workers there is still one queue, which is drained by RunPendingTask() */
+		for (size_t i{}; i < std::max(nrOfThreads, size_t(1)); ++i)
+		{
+			m_Queues.emplace_back(new TaskQueue{});
+		}
+
+		m_Threads.reserve(nrOfThreads);
+
+		for (size_t i{}; i < nrOfThreads; ++i)
+		{
+			m_Threads.emplace_back(&ThreadPool::WorkerLoop, this, i);
+		}
+	}
+
+	ThreadPool::~ThreadPool()
+	{
+		{
+			const std::lock_guard<std::mutex> lock{ m_SleepMutex };
+			m_IsShuttingDown = true;
+		}
+
+		m_ConditionVariable.notify_all();
+
+		for (std::thread& thread : m_Threads)
+		{
+			thread.join();
+		}
+	}
+
+	ThreadPool& ThreadPool::GetInstance()
+	{
+		static std::once_flag onceFlag{};
+
+		std::call_once(onceFlag, []()->void
+			{
+				m_pInstance.reset(new ThreadPool{});
+			});
+
+		return *m_pInstance.get();
+	}
+
+	void ThreadPool::Submit(std::function<void()> task)
+	{
+		const size_t queueIndex{ m_pCurrentPool == this ? m_CurrentWorkerIndex : m_NextQueue++ % m_Queues.size() };
+
+		/* Counted before it is pushed, a worker can take the task as soon as it is in the queue and must never count below zero */
+		++m_NrOfPendingTasks;
+
+		{
+			TaskQueue& queue{ *m_Queues[queueIndex] };
+
+			const std::lock_guard<std::mutex> lock{ queue.Mutex };
+			queue.Tasks.push_back(std::move(task));
+		}
+
+		{
+			/* Taking the lock makes sure a worker that is about to sleep sees the new task */
+			const std::lock_guard<std::mutex> lock{ m_SleepMutex };
+		}
+
+		m_ConditionVariable.notify_one();
+	}
+
+	bool ThreadPool::RunPendingTask()
+	{
+		return TryRunTask(m_pCurrentPool == this ? m_CurrentWorkerIndex : m_NextQueue++ % m_Queues.size());
+	}
+
+	void ThreadPool::ParallelFor(const size_t count, const size_t grainSize, const std::function<void(size_t, size_t)>& function)
+	{
+		assert(grainSize > 0 && "ThreadPool::ParallelFor() > The grain size must be at least 1");
+
+		if (count == 0)
+		{
+			return;
+		}
+
+		const size_t nrOfChunks{ (count + grainSize - 1) / grainSize };
+
+		if (nrOfChunks == 1 || m_Threads.empty())
+		{
+			function(0, count);
+			return;
+		}
+
+		/* Workers that only get to the job after every chunk is done still touch it, so it has to outlive this call */
+		const std::shared_ptr<ParallelForJob> pJob{ new ParallelForJob{ &function, count, grainSize, nrOfChunks, 0, 0 } };
+
+		for (size_t i{}; i < std::min(m_Threads.size(), nrOfChunks - 1); ++i)
+		{
+			Submit([pJob]()->void
+				{
+					RunChunks(*pJob);
+				});
+		}
+
+		RunChunks(*pJob);
+
+		size_t completedChunks{ pJob->CompletedChunks.load() };
+
+		while (completedChunks != nrOfChunks)
+		{
+			pJob->CompletedChunks.wait(completedChunks);
+			completedChunks = pJob->CompletedChunks.load();
+		}
+	}
+
+	size_t ThreadPool::GetDefaultNrOfThreads()
+	{
+		return std::max(std::thread::hardware_concurrency(), 1u) - 1;
+	}
+
+	void ThreadPool::RunChunks(ParallelForJob& job)
+	{
+		for (size_t chunk{ job.NextChunk++ }; chunk < job.NrOfChunks; chunk = job.NextChunk++)
+		{
+			const size_t begin{ chunk * job.GrainSize };
+
+			(*job.pFunction)(begin, std::min(begin + job.GrainSize, job.Count));
+
+			if (++job.CompletedChunks == job.NrOfChunks)
+			{
+				job.CompletedChunks.notify_all();
+			}
+		}
+	}
+
+	void ThreadPool::WorkerLoop(const size_t workerIndex)
+	{
+		m_pCurrentPool = this;
+		m_CurrentWorkerIndex = workerIndex;
+
+		for (;;)
+		{
+			if (TryRunTask(workerIndex))
+			{
+				continue;
+			}
+
+			std::unique_lock<std::mutex> lock{ m_SleepMutex };
+
+			m_ConditionVariable.wait(lock, [this]()->bool
+				{
+					return m_IsShuttingDown || m_NrOfPendingTasks > 0;
+				});
+
+			if (m_IsShuttingDown && m_NrOfPendingTasks == 0)
+			{
+				return;
+			}
+		}
+	}
+
+	bool ThreadPool::TryRunTask(const size_t queueIndex)
+	{
+		std::function<void()> task{};
+
+		/* Newest task of our own queue first, it is the most likely to still be in cache */
+		{
+			TaskQueue& queue{ *m_Queues[queueIndex] };
+
+			const std::lock_guard<std::mutex> lock{ queue.Mutex };
+
+			if (!queue.Tasks.empty())
+			{
+				task = std::move(queue.Tasks.back());
+				queue.Tasks.pop_back();
+			}
+		}
+
+		/* Otherwise steal the oldest task of another queue */
+		for (size_t i{ 1 }; !task && i < m_Queues.size(); ++i)
+		{
+			TaskQueue& queue{ *m_Queues[(queueIndex + i) % m_Queues.size()] };
+
+			const std::lock_guard<std::mutex> lock{ queue.Mutex };
+
+			if (!queue.Tasks.empty())
+			{
+				task = std::move(queue.Tasks.front());
+				queue.Tasks.pop_front();
+			}
+		}
+
+		if (!task)
+		{
+			return false;
+		}
+
+		--m_NrOfPendingTasks;
+
+		task();
+
+		return true;
+	}
+}
\ No newline at end of file
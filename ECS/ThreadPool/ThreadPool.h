@@ -0,0 +1,79 @@
+#pragma once
+
+#include <atomic> /* std::atomic */
+#include <condition_variable> /* std::condition_variable */
+#include <deque> /* std::deque */
+#include <functional> /* std::function */
+#include <memory> /* std::shared_ptr, std::unique_ptr */
+#include <mutex> /* std::mutex */
+#include <thread> /* std::thread */
+#include <vector> /* std::vector */
+
+namespace ECS
+{
+	/* Persistent worker threads that the Registry hands to its views and the SystemScheduler.
+	   Every worker has its own task queue: it runs its newest task first and steals the oldest task of another worker when it runs dry */
+	class ThreadPool final
+	{
+	public:
+		/* The thread waiting on the work helps out, so by default there is one worker less than there are cores */
+		explicit ThreadPool(const size_t nrOfThreads = GetDefaultNrOfThreads());
+		~ThreadPool();
+
+		ThreadPool(const ThreadPool&) noexcept = delete;
+		ThreadPool(ThreadPool&&) noexcept = delete;
+		ThreadPool& operator=(const ThreadPool&) noexcept = delete;
+		ThreadPool& operator=(ThreadPool&&) noexcept = delete;
+
+		static ThreadPool& GetInstance();
+
+		/* Called from a worker, the task goes to that worker's own queue. Otherwise the queues are filled round-robin */
+		void Submit(std::function<void()> task);
+
+		/* Steals and runs a single queued task on the calling thread, returns false if there was nothing to run */
+		bool RunPendingTask();
+
+		/* Splits [0, count) into chunks of at most grainSize and calls function(begin, end) for every chunk.
+		   Blocks until every chunk has been processed */
+		void ParallelFor(const size_t count, const size_t grainSize, const std::function<void(size_t, size_t)>& function);
+
+		[[nodiscard]] size_t GetNrOfThreads() const { return m_Threads.size(); }
+
+	private:
+		struct ParallelForJob final
+		{
+			const std::function<void(size_t, size_t)>* pFunction;
+			size_t Count;
+			size_t GrainSize;
+			size_t NrOfChunks;
+			std::atomic<size_t> NextChunk;
+			std::atomic<size_t> CompletedChunks;
+		};
+
+		struct TaskQueue final
+		{
+			std::mutex Mutex;
+			std::deque<std::function<void()>> Tasks;
+		};
+
+		static size_t GetDefaultNrOfThreads();
+		static void RunChunks(ParallelForJob& job);
+
+		void WorkerLoop(const size_t workerIndex);
+		bool TryRunTask(const size_t queueIndex);
+
+		inline static std::unique_ptr<ThreadPool> m_pInstance{};
+
+		/* Lets Submit() find the queue of the worker it is called from */
+		inline static thread_local const ThreadPool* m_pCurrentPool{};
+		inline static thread_local size_t m_CurrentWorkerIndex{};
+
+		std::vector<std::unique_ptr<TaskQueue>> m_Queues;
+		std::vector<std::thread> m_Threads;
+		std::atomic<size_t> m_NrOfPendingTasks;
+		std::atomic<size_t> m_NextQueue;
+		std::mutex m_SleepMutex;
+		std::condition_variable m_ConditionVariable;
+		bool m_IsShuttingDown;
+	};
+}
\ No newline at end of file
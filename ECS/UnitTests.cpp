@@ -3,14 +3,42 @@
 
 #include "ECSConstants.h"
 
+#include "Archetype/ArchetypeRegistry.h"
+#include "ComponentArray/PagedComponentStorage.h"
+#include "ComponentArray/SoAComponentStorage.h"
 #include "Registry/Registry.h"
+#include "Scheduler/SystemScheduler.h"
 #include "ECSComponents/ECSComponents.h"
+#include "Point2f/Point2fMath.h"
+
+#include <atomic>
+#include <iterator>
+#include <memory_resource>
+#include <stdexcept>
+#include <utility>
 
 int RunUnitTests(int argc, char* argv[])
 {
 	return Catch::Session().run(argc, argv);
 }
 
+/* Forwards to the new_delete_resource and counts how many bytes were requested from it */
+struct CountingResource final : std::pmr::memory_resource
+{
+	size_t NrOfBytes{};
+
+	void* do_allocate(const size_t bytes, const size_t alignment) override
+	{
+		NrOfBytes += bytes;
+		return std::pmr::new_delete_resource()->allocate(bytes, alignment);
+	}
+	void do_deallocate(void* const p, const size_t bytes, const size_t alignment) override
+	{
+		std::pmr::new_delete_resource()->deallocate(p, bytes, alignment);
+	}
+	bool do_is_equal(const std::pmr::memory_resource& other) const noexcept override { return this == &other; }
+};
+
 TEST_CASE("Testing SparseSet")
 {
 	ECS::SparseSet<int> set{};
@@ -50,8 +78,384 @@ TEST_CASE("Testing SparseSet")
 
 		REQUIRE(set.Size() == 0);
 	}
+
+	SECTION("Removing keeps the remaining values packed")
+	{
+		for (int i{}; i < 5; ++i)
+		{
+			set.Add(i);
+		}
+
+		set.Remove(1);
+		set.Add(7);
+
+		REQUIRE(set.Size() == 5);
+		REQUIRE(!set.Contains(1));
+		REQUIRE(std::distance(set.begin(), set.end()) == 5);
+
+		for (const int value : { 0, 2, 3, 4, 7 })
+		{
+			REQUIRE(set.Contains(value));
+			REQUIRE(set[value] == value);
+		}
+	}
+
+	SECTION("Adding values far apart")
+	{
+		constexpr int highValue{ static_cast<int>(ECS::SparsePageSize) * 100 + 3 };
+
+		set.Add(highValue);
+		set.Add(1);
+
+		REQUIRE(set.Size() == 2);
+		REQUIRE(set.Contains(highValue));
+		REQUIRE(set.Contains(1));
+		REQUIRE(!set.Contains(highValue - 1));
+		REQUIRE(!set.Contains(static_cast<int>(ECS::SparsePageSize) * 50));
+	}
+
+	SECTION("Reserving a sparse array does not allocate its pages")
+	{
+		CountingResource resource{};
+
+		{
+			ECS::PagedSparseArray sparse{ &resource };
+
+			sparse.Reserve(ECS::SparsePageSize * 10);
+
+			REQUIRE(resource.NrOfBytes < ECS::SparsePageSize * sizeof(ECS::Entity));
+
+			sparse.AllocatePages(0, ECS::SparsePageSize * 10);
+
+			REQUIRE(resource.NrOfBytes >= ECS::SparsePageSize * sizeof(ECS::Entity) * 10);
+		}
+
+		resource.NrOfBytes = 0;
+
+		{
+			ECS::SparseSet<ECS::Entity> entities{ &resource };
+
+			entities.Reserve(ECS::SparsePageSize * 10);
+
+			/* The packed values and the page table, but none of the ten pages */
+			REQUIRE(resource.NrOfBytes < ECS::SparsePageSize * sizeof(ECS::Entity) * 11);
+		}
+	}
+}
+
+TEST_CASE("Testing ComponentArray")
+{
+	ECS::ComponentArray<int> components{};
+
+	for (ECS::Entity i{}; i < 5; ++i)
+	{
+		components.AddComponent(i, static_cast<int>(i) * 10);
+	}
+
+	SECTION("Removing moves the last component into the freed slot")
+	{
+		components.Remove(1);
+
+		REQUIRE(components.Size() == 4);
+		REQUIRE(!components.HasEntity(1));
+
+		for (const ECS::Entity entity : { 0u, 2u, 3u, 4u })
+		{
+			REQUIRE(components.GetComponent(entity) == static_cast<int>(entity) * 10);
+		}
+
+		components.Remove(4);
+		components.AddComponent(1, 100);
+
+		REQUIRE(components.Size() == 4);
+		REQUIRE(components.GetComponent(1) == 100);
+		REQUIRE(components.GetComponent(3) == 30);
+	}
+
+	SECTION("Adding entities with reserved indices does not allocate")
+	{
+		CountingResource resource{};
+
+		{
+			ECS::ComponentArray<GravityComponent> pool{ &resource };
+
+			pool.Reserve(ECS::SparsePageSize * 2);
+			pool.ReserveIndices(0, ECS::SparsePageSize * 2);
+
+			const size_t nrOfReservedBytes{ resource.NrOfBytes };
+
+			for (ECS::Entity entity{}; entity < ECS::SparsePageSize * 2; ++entity)
+			{
+				pool.AddComponent(entity);
+			}
+
+			REQUIRE(resource.NrOfBytes == nrOfReservedBytes);
+			REQUIRE(pool.Size() == ECS::SparsePageSize * 2);
+		}
+	}
+}
+
+struct SoATestData final
+{
+	Point2f Position;
+	float Mass;
+};
+
+template<>
+struct ECS::ComponentTraits<SoATestData>
+{
+	using StorageType = ECS::SoAComponentStorage<SoATestData, &SoATestData::Position, &SoATestData::Mass>;
+};
+
+TEST_CASE("Testing SoA component storage")
+{
+	ECS::Registry registry{};
+
+	for (int i{}; i < 5; ++i)
+	{
+		const ECS::Entity entity{ registry.CreateEntity() };
+
+		registry.AddComponent<SoATestData>(entity, Point2f{ static_cast<float>(i), 0.f }, static_cast<float>(i) * 10.f);
+		registry.AddComponent<GravityComponent>(entity);
+	}
+
+	SECTION("Every member is stored in its own column")
+	{
+		ECS::ComponentArray<SoATestData> components{};
+
+		for (ECS::Entity i{}; i < 5; ++i)
+		{
+			components.AddComponent(i, Point2f{}, static_cast<float>(i));
+		}
+
+		const auto& masses{ components.GetStorage().GetColumn<&SoATestData::Mass>() };
+
+		REQUIRE(masses.size() == 5);
+		REQUIRE(masses[4] == 4.f);
+
+		const SoATestData data = registry.GetComponent<SoATestData>(3);
+
+		REQUIRE(data.Position.x == 3.f);
+		REQUIRE(data.Mass == 30.f);
+		REQUIRE(registry.GetComponent<SoATestData>(2).Get<&SoATestData::Mass>() == 20.f);
+	}
+
+	SECTION("Views hand out proxies that write through to the columns")
+	{
+		registry.CreateView<const GravityComponent, SoATestData>().ForEach([](const GravityComponent& gravity, ECS::ComponentReference<SoATestData> data)->void
+			{
+				data.Get<&SoATestData::Position>().y += gravity.Gravity;
+			});
+
+		for (ECS::Entity entity{}; entity < 5; ++entity)
+		{
+			REQUIRE(registry.GetComponent<SoATestData>(entity).Get<&SoATestData::Position>().y == GravityComponent{}.Gravity);
+			REQUIRE(registry.GetComponent<SoATestData>(entity).Get<&SoATestData::Mass>() == static_cast<float>(entity) * 10.f);
+		}
+
+		float totalMass{};
+
+		registry.CreateView<const SoATestData>().ForEach([&totalMass](ECS::ComponentReference<const SoATestData> data)->void
+			{
+				totalMass += data.Get<&SoATestData::Mass>();
+			});
+
+		REQUIRE(totalMass == 100.f);
+
+		/* Assigning one proxy to another copies the row, like assigning references would */
+		const ECS::ComponentReference<SoATestData> first{ registry.GetComponent<SoATestData>(0) };
+		const ECS::ComponentReference<SoATestData> second{ registry.GetComponent<SoATestData>(1) };
+
+		first = second;
+
+		REQUIRE(registry.GetComponent<SoATestData>(0).Get<&SoATestData::Mass>() == 10.f);
+		REQUIRE(second.Get<&SoATestData::Mass>() == 10.f);
+	}
+
+	SECTION("Removing keeps every column packed")
+	{
+		registry.RemoveComponent<SoATestData>(1);
+		registry.GetComponent<SoATestData>(0) = SoATestData{ Point2f{ -1.f, -1.f }, -10.f };
+
+		REQUIRE(!registry.HasComponent<SoATestData>(1));
+		REQUIRE(registry.GetComponent<SoATestData>(4).Get<&SoATestData::Mass>() == 40.f);
+		REQUIRE(registry.GetComponent<SoATestData>(0).Get<&SoATestData::Mass>() == -10.f);
+	}
+}
+
+struct PagedTestData final
+{
+	std::string Name;
+};
+
+template<>
+struct ECS::ComponentTraits<PagedTestData>
+{
+	using StorageType = ECS::PagedComponentStorage<PagedTestData, 64>;
+};
+
+TEST_CASE("Testing paged component storage")
+{
+	ECS::Registry registry{};
+
+	const ECS::Entity first{ registry.CreateEntity() };
+	PagedTestData* const pFirst{ &registry.AddComponent<PagedTestData>(first, "First") };
+
+	std::vector<ECS::Entity> entities{};
+
+	for (int i{}; i < 1'000; ++i)
+	{
+		const ECS::Entity entity{ registry.CreateEntity() };
+
+		registry.AddComponent<PagedTestData>(entity, std::to_string(i));
+		entities.push_back(entity);
+	}
+
+	SECTION("Growing never moves a component")
+	{
+		REQUIRE(&registry.GetComponent<PagedTestData>(first) == pFirst);
+		REQUIRE(pFirst->Name == "First");
+		REQUIRE(registry.GetCapacity<PagedTestData>() == 1'024);
+	}
+
+	SECTION("Removing keeps the pool packed")
+	{
+		for (size_t i{}; i < entities.size(); i += 2)
+		{
+			registry.RemoveComponent<PagedTestData>(entities[i]);
+		}
+
+		size_t counter{};
+
+		registry.CreateView<const PagedTestData>().ForEach([&counter](const PagedTestData&)->void { ++counter; });
+
+		REQUIRE(counter == 501);
+		REQUIRE(registry.GetComponent<PagedTestData>(entities[999]).Name == "999");
+		REQUIRE(&registry.GetComponent<PagedTestData>(first) == pFirst);
+
+		registry.ShrinkToFit<PagedTestData>();
+
+		REQUIRE(registry.GetCapacity<PagedTestData>() == 512);
+		REQUIRE(registry.GetComponent<PagedTestData>(entities[1]).Name == "1");
+	}
+
+	SECTION("Moving between resources copies the pages")
+	{
+		CountingResource first{};
+		CountingResource second{};
+
+		ECS::PagedComponentStorage<PagedTestData, 64> source{ &first };
+		ECS::PagedComponentStorage<PagedTestData, 64> target{ &second };
+
+		for (int i{}; i < 100; ++i)
+		{
+			source.Emplace(std::to_string(i));
+		}
+
+		target = std::move(source);
+
+		REQUIRE(source.Size() == 0);
+		REQUIRE(source.Capacity() == 0);
+		REQUIRE(target.Size() == 100);
+		REQUIRE(target[99].Name == "99");
+		REQUIRE(second.NrOfBytes >= 2 * 64 * sizeof(PagedTestData));
+
+		ECS::PagedSparseArray sparse{ &first };
+		ECS::PagedSparseArray otherSparse{ &second };
+
+		sparse.Assure(ECS::SparsePageSize * 3) = 7;
+		otherSparse = std::move(sparse);
+
+		REQUIRE(otherSparse.Get(ECS::SparsePageSize * 3) == 7);
+		REQUIRE(sparse.Get(ECS::SparsePageSize * 3) == ECS::InvalidEntityID);
+	}
+}
+
+TEST_CASE("Testing Point2f batch math")
+{
+	/* Odd sizes make every kernel run its vector loop and its remainder */
+	constexpr size_t size{ 13 };
+
+	std::vector<Point2f> points{};
+	std::vector<Point2f> others{};
+
+	for (size_t i{}; i < size; ++i)
+	{
+		points.push_back(Point2f{ static_cast<float>(i), -static_cast<float>(i) });
+		others.push_back(Point2f{ 0.5f, static_cast<float>(i) * 2.f });
+	}
+
+	const std::vector<Point2f> original{ points };
+
+	SECTION("Adding")
+	{
+		ECS::Math::Add(points, others);
+
+		for (size_t i{}; i < size; ++i)
+		{
+			REQUIRE(points[i] == original[i] + others[i]);
+		}
+	}
+
+	SECTION("Multiplying and adding")
+	{
+		/* The products are not exact, so a kernel that fuses the multiply and the add would round differently */
+		ECS::Math::MultiplyAdd(points, others, 0.7f);
+
+		for (size_t i{}; i < size; ++i)
+		{
+			REQUIRE(points[i] == original[i] + others[i] * 0.7f);
+		}
+	}
+
+	SECTION("Scaling")
+	{
+		ECS::Math::Scale(std::span<Point2f>{ points }.subspan(1), 4.f);
+
+		REQUIRE(points[0] == original[0]);
+
+		for (size_t i{ 1 }; i < size; ++i)
+		{
+			REQUIRE(points[i] == 4.f * original[i]);
+		}
+	}
 }
 
+TEST_CASE("Testing ComponentIDGenerator")
+{
+	struct FirstIDTestData {};
+	struct SecondIDTestData {};
+
+	const ECS::ComponentType firstID{ ECS::GenerateComponentID<FirstIDTestData>() };
+	const ECS::ComponentType secondID{ ECS::GenerateComponentID<SecondIDTestData>() };
+
+	REQUIRE(firstID != secondID);
+	REQUIRE(firstID < ECS::MaxComponentTypes);
+	REQUIRE(secondID < ECS::MaxComponentTypes);
+	REQUIRE(ECS::GenerateComponentID<FirstIDTestData>() == firstID);
+	REQUIRE(ECS::GenerateComponentID<const FirstIDTestData>() == firstID);
+	REQUIRE(ECS::GenerateComponentID<FirstIDTestData&>() == firstID);
+}
+
+/* Counts every time it is copied or moved */
+struct MoveCounter final
+{
+	MoveCounter() = default;
+	MoveCounter(const MoveCounter&) { ++NrOfMoves; }
+	MoveCounter(MoveCounter&&) noexcept { ++NrOfMoves; }
+	MoveCounter& operator=(const MoveCounter&) = default;
+	MoveCounter& operator=(MoveCounter&&) noexcept = default;
+
+	inline static int NrOfMoves{};
+};
+
+struct MoveCountingData final
+{
+	float Value;
+	Point2f Position;
+	MoveCounter Counter{};
+};
+
 TEST_CASE("Testing custom ECS")
 {
 	ECS::Registry registry{};
@@ -73,7 +477,52 @@ TEST_CASE("Testing custom ECS")
 
 		registry.ReleaseEntity(entity);
 
-		REQUIRE(registry.CreateEntity() == 0);
+		const ECS::Entity recycledEntity{ registry.CreateEntity() };
+
+		REQUIRE(ECS::GetEntityIndex(recycledEntity) == 0);
+		REQUIRE(recycledEntity != entity);
+	}
+
+	SECTION("Stale entities do not alias recycled ones")
+	{
+		ECS::Entity entity{ registry.CreateEntity() };
+
+		registry.AddComponent<GravityComponent>(entity);
+		registry.ReleaseEntity(entity);
+
+		const ECS::Entity recycledEntity{ registry.CreateEntity() };
+
+		REQUIRE(ECS::GetEntityVersion(recycledEntity) == ECS::GetEntityVersion(entity) + 1);
+		REQUIRE(registry.HasEntity(recycledEntity));
+		REQUIRE(!registry.HasEntity(entity));
+		REQUIRE(!registry.ReleaseEntity(entity));
+
+		registry.AddComponent<GravityComponent>(recycledEntity);
+
+		REQUIRE(registry.HasComponent<GravityComponent>(recycledEntity));
+		REQUIRE(!registry.HasComponent<GravityComponent>(entity));
+	}
+
+	SECTION("Invalid entities are never reported as alive")
+	{
+		REQUIRE(!registry.HasEntity(ECS::InvalidEntityID));
+		REQUIRE(!registry.HasComponent<GravityComponent>(ECS::InvalidEntityID));
+		REQUIRE(!registry.ReleaseEntity(ECS::InvalidEntityID));
+
+		ECS::Entity entity{ registry.CreateEntity() };
+
+		registry.AddComponent<GravityComponent>(entity);
+		registry.ReleaseEntity(entity);
+
+		const ECS::Entity forgedEntity{ ECS::CreateEntityID(ECS::GetEntityIndex(entity), ECS::GetEntityVersion(ECS::InvalidEntityID)) };
+
+		REQUIRE(!registry.HasEntity(forgedEntity));
+		REQUIRE(!registry.HasComponent<GravityComponent>(forgedEntity));
+		REQUIRE(!registry.ReleaseEntity(forgedEntity));
+
+		ECS::SparseSet<ECS::Entity> set{};
+
+		REQUIRE(!set.Contains(ECS::InvalidEntityID));
 	}
 
 	SECTION("Making 10 entities and testing their updates")
@@ -139,48 +588,1033 @@ TEST_CASE("Testing custom ECS")
 		}
 	}
 
-	SECTION("Removing Entities")
+	SECTION("Adding a component brace initialises it from the arguments")
 	{
-		struct RemoveEntityTestData
-		{
-			std::string Name;
-		};
+		const ECS::Entity entity{ registry.CreateEntity() };
 
-		for (int i{}; i < 5; ++i)
-		{
-			ECS::Entity entity{ registry.CreateEntity() };
+		/* Velocity is brace elided from the last two arguments */
+		const RigidBodyComponent& rigidBody{ registry.AddComponent<RigidBodyComponent>(entity, 2.f, 1.f, 3.f) };
 
-			registry.AddComponent<RemoveEntityTestData>(entity, std::to_string(i));
+		REQUIRE(rigidBody.Mass == 2.f);
+		REQUIRE(rigidBody.Velocity.x == 1.f);
+		REQUIRE(rigidBody.Velocity.y == 3.f);
+	}
+
+	SECTION("Adding a component constructs it in place")
+	{
+		MoveCounter::NrOfMoves = 0;
+
+		registry.Reserve<MoveCountingData>(10);
+
+		const MoveCountingData& data{ registry.AddComponent<MoveCountingData>(registry.CreateEntity(), 1.f, 2.f, 3.f) };
+		registry.AddComponent<MoveCountingData>(registry.CreateEntity());
+
+		ECS::Entity entities[5]{};
+		registry.CreateEntities<MoveCountingData>(std::size(entities), entities);
+
+		REQUIRE(MoveCounter::NrOfMoves == 0);
+		REQUIRE(data.Value == 1.f);
+		REQUIRE(data.Position.y == 3.f);
+	}
+
+	SECTION("Creating entities together with their components")
+	{
+		auto& group = registry.CreateGroup<GravityComponent, RigidBodyComponent>();
+
+		const ECS::Entity entity{ registry.CreateEntity<GravityComponent, RigidBodyComponent>(GravityComponent{ 5.f }, RigidBodyComponent{ 2.f }) };
+
+		REQUIRE(registry.GetComponent<GravityComponent>(entity).Gravity == 5.f);
+		REQUIRE(registry.GetComponent<RigidBodyComponent>(entity).Mass == 2.f);
+		REQUIRE(group.Contains(entity));
+
+		const ECS::Entity defaultEntity{ registry.CreateEntity<GravityComponent>() };
+
+		REQUIRE(registry.GetComponent<GravityComponent>(defaultEntity).Gravity == GravityComponent{}.Gravity);
+		REQUIRE(!group.Contains(defaultEntity));
+
+		std::vector<ECS::Entity> entities{};
+		registry.CreateEntities<GravityComponent, RigidBodyComponent>(1'000, std::back_inserter(entities));
+
+		REQUIRE(entities.size() == 1'000);
+		REQUIRE(registry.GetAmountOfEntities() == 1'002);
+		REQUIRE(group.Size() == 1'001);
+
+		for (const ECS::Entity created : entities)
+		{
+			if (!registry.HasComponent<GravityComponent>(created) || !registry.HasComponent<RigidBodyComponent>(created))
+			{
+				FAIL("Entity was created without its components");
+			}
 		}
 
-		registry.ReleaseEntity(3);
+		ECS::Entity plainEntities[10]{};
+		registry.CreateEntities(10, plainEntities);
 
-		REQUIRE(registry.GetAmountOfEntities() == 4);
-		REQUIRE(registry.GetComponent<RemoveEntityTestData>(2).Name == "2");
-		REQUIRE(registry.GetComponent<RemoveEntityTestData>(4).Name == "4");
+		REQUIRE(registry.GetAmountOfEntities() == 1'012);
+		REQUIRE(!registry.HasComponent<GravityComponent>(plainEntities[9]));
 	}
 
-	SECTION("Creating many entities")
+	SECTION("Creating entities only allocates the sparse pages of their indices")
 	{
-		struct EntityTest final
+		CountingResource resource{};
+
 		{
-			std::string Name;
-		};
+			ECS::Registry countedRegistry{ &resource };
 
-#pragma warning ( push )
-#pragma warning ( disable:4834 )
-		for (size_t i{}; i < 10; ++i) registry.CreateEntity();
-#pragma warning ( pop )
+			countedRegistry.Reserve(ECS::SparsePageSize * 6);
 
-		ECS::Entity entity{ registry.CreateEntity() };
+			ECS::Entity plainEntities[ECS::SparsePageSize * 5]{};
+			countedRegistry.CreateEntities(std::size(plainEntities), plainEntities);
 
-		registry.AddComponent<EntityTest>(entity, "Entity");
+			const size_t nrOfBytesBefore{ resource.NrOfBytes };
 
-		auto view = registry.CreateView<EntityTest>();
+			ECS::Entity entities[100]{};
+			countedRegistry.CreateEntities<GravityComponent>(std::size(entities), entities);
 
-		view.ForEach([](const auto& test)->void
-			{
-				REQUIRE(test.Name == "Entity");
+			/* Only the page holding the new indices, not the ones below them */
+			REQUIRE(resource.NrOfBytes - nrOfBytesBefore < ECS::SparsePageSize * sizeof(ECS::Entity) * 2);
+			REQUIRE(countedRegistry.HasComponent<GravityComponent>(entities[99]));
+
+			/* Reserving for a range of entities allocates their pages up front, adding the components after that does not allocate */
+			countedRegistry.Reserve<RigidBodyComponent>(100, plainEntities[ECS::SparsePageSize * 4]);
+
+			const size_t nrOfReservedBytes{ resource.NrOfBytes };
+
+			for (size_t i{}; i < 100; ++i)
+			{
+				countedRegistry.AddComponent<RigidBodyComponent>(plainEntities[ECS::SparsePageSize * 4 + i]);
+			}
+
+			REQUIRE(resource.NrOfBytes == nrOfReservedBytes);
+			REQUIRE(nrOfReservedBytes - nrOfBytesBefore < ECS::SparsePageSize * sizeof(ECS::Entity) * 4);
+		}
+	}
+
+	SECTION("Reserving keeps the pools from reallocating")
+	{
+		registry.Reserve(1'000);
+		registry.Reserve<GravityComponent>(1'000);
+
+		REQUIRE(registry.GetCapacity<GravityComponent>() >= 1'000);
+		REQUIRE(registry.GetCapacity<RigidBodyComponent>() == 0);
+
+		const ECS::Entity first{ registry.CreateEntity<GravityComponent>() };
+		const GravityComponent* const pFirst{ &registry.GetComponent<GravityComponent>(first) };
+
+		for (int i{}; i < 999; ++i)
+		{
+			registry.AddComponent<GravityComponent>(registry.CreateEntity());
+		}
+
+		REQUIRE(&registry.GetComponent<GravityComponent>(first) == pFirst);
+
+		for (ECS::Entity entity{ 1 }; entity < 1'000; ++entity)
+		{
+			registry.ReleaseEntity(entity);
+		}
+
+		registry.ShrinkToFit<GravityComponent>();
+
+		REQUIRE(registry.GetCapacity<GravityComponent>() == 1);
+		REQUIRE(registry.GetComponent<GravityComponent>(first).Gravity == GravityComponent{}.Gravity);
+
+		registry.ShrinkToFit();
+
+		REQUIRE(registry.HasEntity(first));
+	}
+
+	SECTION("Pools allocate from the memory resource of their registry")
+	{
+		struct ArenaTestData
+		{
+			std::string Name;
+		};
+
+		struct DefaultResourceGuard final
+		{
+			DefaultResourceGuard() : pPrevious{ std::pmr::set_default_resource(std::pmr::null_memory_resource()) } {}
+			~DefaultResourceGuard() { std::pmr::set_default_resource(pPrevious); }
+
+			std::pmr::memory_resource* pPrevious;
+		};
+
+		std::pmr::monotonic_buffer_resource arena{};
+
+		{
+			/* Any allocation of the registry that does not go through the arena now throws */
+			const DefaultResourceGuard guard{};
+
+			ECS::Registry arenaRegistry{ &arena };
+
+			REQUIRE(arenaRegistry.GetMemoryResource() == &arena);
+
+			const auto& cachedGroup = arenaRegistry.CreateCachedGroup<GravityComponent, ArenaTestData>();
+
+			for (int i{}; i < 100; ++i)
+			{
+				const ECS::Entity entity{ arenaRegistry.CreateEntity() };
+
+				arenaRegistry.AddComponent<GravityComponent>(entity);
+				arenaRegistry.AddComponent<ArenaTestData>(entity, "Entity");
+			}
+
+			arenaRegistry.ReleaseEntity(5);
+
+			size_t counter{};
+			arenaRegistry.CreateView<GravityComponent, ArenaTestData>().ForEach([&counter](auto&, auto&)->void { ++counter; });
+
+			REQUIRE(counter == 99);
+			REQUIRE(cachedGroup.Size() == 99);
+		}
+	}
+
+	SECTION("Moving a registry keeps allocating from a single resource")
+	{
+		CountingResource first{};
+		CountingResource second{};
+
+		{
+			ECS::Registry source{ &first };
+			ECS::Registry target{ &first };
+			ECS::Registry unrelated{ &second };
+
+			for (int i{}; i < 10; ++i)
+			{
+				source.AddComponent<GravityComponent>(source.CreateEntity());
+			}
+
+			target = std::move(source);
+
+			REQUIRE(target.GetMemoryResource() == &first);
+			REQUIRE(target.GetAmountOfEntities() == 10);
+
+			const size_t nrOfBytesBefore{ first.NrOfBytes };
+
+			for (int i{}; i < 10; ++i)
+			{
+				target.AddComponent<RigidBodyComponent>(target.CreateEntity());
+			}
+
+			REQUIRE(first.NrOfBytes > nrOfBytesBefore);
+			REQUIRE(second.NrOfBytes == 0);
+			REQUIRE(unrelated.GetMemoryResource() == &second);
+		}
+	}
+
+	SECTION("Tag components have no storage")
+	{
+		struct StunnedTag {};
+
+		std::vector<ECS::Entity> entities{};
+
+		for (int i{}; i < 10; ++i)
+		{
+			const ECS::Entity entity{ registry.CreateEntity<GravityComponent>() };
+
+			if (i % 2 == 0)
+			{
+				registry.AddComponent<StunnedTag>(entity);
+			}
+
+			entities.push_back(entity);
+		}
+
+		REQUIRE(ECS::ComponentArray<StunnedTag>::IsTag);
+		REQUIRE(!ECS::ComponentArray<GravityComponent>::IsTag);
+		REQUIRE(&registry.GetComponent<StunnedTag>(entities[0]) == &registry.GetComponent<StunnedTag>(entities[2]));
+
+		registry.RemoveComponent<StunnedTag>(entities[4]);
+		registry.ReleaseEntity(entities[6]);
+
+		REQUIRE(!registry.HasComponent<StunnedTag>(entities[4]));
+		REQUIRE(registry.HasComponent<StunnedTag>(entities[8]));
+
+		size_t counter{};
+
+		registry.CreateView<const StunnedTag, GravityComponent>().ForEach([&counter](const StunnedTag&, GravityComponent&)->void
+			{
+				++counter;
+			});
+
+		REQUIRE(counter == 3);
+
+		auto& group = registry.CreateGroup<StunnedTag, GravityComponent>();
+
+		REQUIRE(group.Size() == 3);
+
+		registry.Reserve<StunnedTag>(100);
+
+		REQUIRE(registry.GetCapacity<StunnedTag>() >= 100);
+		REQUIRE(registry.GetCapacity<StunnedTag>() < 1000);
+
+		/* A tag only remembers when it was added, handing it out mutably does not change it */
+		const ECS::Tick lastRun{ registry.AdvanceTick() };
+
+		registry.AddComponent<StunnedTag>(entities[1]);
+		group.ForEach([](StunnedTag&, GravityComponent&)->void {});
+
+		size_t nrOfAdded{};
+		size_t nrOfChanged{};
+
+		registry.CreateView<GravityComponent, ECS::Added<StunnedTag>>(lastRun).ForEach([&nrOfAdded](GravityComponent&)->void
+			{
+				++nrOfAdded;
+			});
+		registry.CreateView<GravityComponent, ECS::Changed<StunnedTag>>(lastRun).ForEach([&nrOfChanged](GravityComponent&)->void
+			{
+				++nrOfChanged;
+			});
+
+		REQUIRE(nrOfAdded == 1);
+		REQUIRE(nrOfChanged == 1);
+	}
+
+	SECTION("Views only visit entities that have every component")
+	{
+		struct RareViewTestData
+		{
+			int Value;
+		};
+
+		for (int i{}; i < 100; ++i)
+		{
+			ECS::Entity entity{ registry.CreateEntity() };
+
+			registry.AddComponent<GravityComponent>(entity);
+
+			if (i % 10 == 0)
+			{
+				registry.AddComponent<RareViewTestData>(entity, i);
+			}
+		}
+
+		int counter{};
+
+		registry.CreateView<GravityComponent, RareViewTestData>().ForEach([&counter](auto&, auto& data)->void
+			{
+				REQUIRE(data.Value % 10 == 0);
+				++counter;
+			});
+
+		REQUIRE(counter == 10);
+	}
+
+	SECTION("Entities keep track of which components they have")
+	{
+		struct SignatureTestData
+		{
+			int Value;
+		};
+
+		const ECS::Entity entity{ registry.CreateEntity<RigidBodyComponent>() };
+
+		REQUIRE(registry.HasComponent<RigidBodyComponent>(entity));
+		REQUIRE(!registry.HasComponent<SignatureTestData>(entity));
+
+		registry.AddComponent<SignatureTestData>(entity, 5);
+
+		REQUIRE(registry.HasComponents<RigidBodyComponent, SignatureTestData>(entity));
+		REQUIRE(registry.GetSignature(entity).count() == 2);
+
+		registry.RemoveComponent<RigidBodyComponent>(entity);
+
+		REQUIRE(!registry.HasComponents<RigidBodyComponent, SignatureTestData>(entity));
+		REQUIRE(registry.GetSignature(entity).test(ECS::GenerateComponentID<SignatureTestData>()));
+
+		registry.ReleaseEntity(entity);
+
+		/* A recycled entity starts without any components */
+		const ECS::Entity recycled{ registry.CreateEntity() };
+
+		REQUIRE(ECS::GetEntityIndex(recycled) == ECS::GetEntityIndex(entity));
+		REQUIRE(!registry.HasComponent<SignatureTestData>(entity));
+		REQUIRE(registry.GetSignature(recycled).none());
+	}
+
+	SECTION("Views can exclude components and make them optional")
+	{
+		struct SleepingTag {};
+		struct NameData
+		{
+			std::string Name;
+		};
+
+		for (int i{}; i < 10; ++i)
+		{
+			const ECS::Entity entity{ registry.CreateEntity<RigidBodyComponent>() };
+
+			if (i % 2 == 0)
+			{
+				registry.AddComponent<SleepingTag>(entity);
+			}
+
+			if (i % 3 == 0)
+			{
+				registry.AddComponent<NameData>(entity, std::to_string(i));
+			}
+		}
+
+		size_t nrOfAwake{};
+		size_t nrOfNamed{};
+
+		registry.CreateView<RigidBodyComponent, ECS::Exclude<SleepingTag>, ECS::Maybe<const NameData>>().ForEach(
+			[&registry, &nrOfAwake, &nrOfNamed](RigidBodyComponent&, const NameData* pName)->void
+			{
+				++nrOfAwake;
+
+				if (pName)
+				{
+					REQUIRE(std::stoi(pName->Name) % 2 == 1);
+					++nrOfNamed;
+				}
+			});
+
+		REQUIRE(nrOfAwake == 5);
+		REQUIRE(nrOfNamed == 2);
+
+		/* Filters on components that have never been added behave as if no entity has them */
+		struct NeverAddedData
+		{
+			int Value;
+		};
+
+		REQUIRE(registry.CanViewBeCreated<RigidBodyComponent, ECS::Exclude<NeverAddedData>, ECS::Maybe<NeverAddedData>>());
+
+		size_t counter{};
+
+		registry.CreateView<ECS::Exclude<NeverAddedData>, const RigidBodyComponent, ECS::Maybe<NeverAddedData>>().ForEach(
+			[&counter](const RigidBodyComponent&, NeverAddedData* pData)->void
+			{
+				REQUIRE(pData == nullptr);
+				++counter;
+			});
+
+		REQUIRE(counter == 10);
+	}
+
+	SECTION("Views can only visit components that changed since a tick")
+	{
+		struct ChangeTestData
+		{
+			int Value;
+		};
+
+		std::vector<ECS::Entity> entities(10);
+		registry.CreateEntities<ChangeTestData>(entities.size(), entities.begin());
+
+		const auto countMatches([&registry]<typename Filter>(const ECS::Tick sinceTick, const std::type_identity<Filter>&)->size_t
+			{
+				size_t counter{};
+
+				registry.CreateView<const ChangeTestData, Filter>(sinceTick).ForEach([&counter](const ChangeTestData&)->void
+					{
+						++counter;
+					});
+
+				return counter;
+			});
+
+		/* Adding counts as a change */
+		REQUIRE(countMatches(0, std::type_identity<ECS::Added<ChangeTestData>>{}) == 10);
+		REQUIRE(countMatches(0, std::type_identity<ECS::Changed<ChangeTestData>>{}) == 10);
+
+		const ECS::Tick lastRun{ registry.AdvanceTick() };
+
+		REQUIRE(registry.GetCurrentTick() == lastRun + 1);
+		REQUIRE(countMatches(lastRun, std::type_identity<ECS::Changed<ChangeTestData>>{}) == 0);
+
+		/* Reading does not count as a change, handing a component out mutably does */
+		const ECS::Registry& constRegistry{ registry };
+
+		registry.CreateView<const ChangeTestData>().ForEach([](const ChangeTestData&)->void {});
+		REQUIRE(constRegistry.GetComponent<ChangeTestData>(entities[0]).Value == 0);
+		REQUIRE(countMatches(lastRun, std::type_identity<ECS::Changed<ChangeTestData>>{}) == 0);
+
+		registry.GetComponent<ChangeTestData>(entities[1]).Value = 1;
+
+		REQUIRE(countMatches(lastRun, std::type_identity<ECS::Changed<ChangeTestData>>{}) == 1);
+
+		/* A system that writes to what it filters on does not get its own writes reported on its next run */
+		size_t nrOfVisited{};
+
+		registry.CreateView<ChangeTestData, ECS::Changed<ChangeTestData>>(lastRun).ForEach([&nrOfVisited](ChangeTestData& data)->void
+			{
+				data.Value = 2;
+				++nrOfVisited;
+			});
+
+		const ECS::Tick secondRun{ registry.AdvanceTick() };
+
+		REQUIRE(nrOfVisited == 1);
+		REQUIRE(countMatches(secondRun, std::type_identity<ECS::Changed<ChangeTestData>>{}) == 0);
+
+		registry.GetComponent<ChangeTestData>(entities[2]).Value = 3;
+		registry.AddComponent<ChangeTestData>(registry.CreateEntity(), 4);
+
+		REQUIRE(countMatches(secondRun, std::type_identity<ECS::Changed<ChangeTestData>>{}) == 2);
+		REQUIRE(countMatches(secondRun, std::type_identity<ECS::Added<ChangeTestData>>{}) == 1);
+
+		/* Ticks follow their components when the pool is reordered */
+		registry.Sort<ChangeTestData>([](const ChangeTestData& lhs, const ChangeTestData& rhs)->bool
+			{
+				return lhs.Value > rhs.Value;
+			});
+		registry.ReleaseEntity(entities[5]);
+
+		int sum{};
+
+		registry.CreateView<const ChangeTestData, ECS::Changed<ChangeTestData>>(secondRun).ForEach([&sum](const ChangeTestData& data)->void
+			{
+				sum += data.Value;
+			});
+
+		REQUIRE(sum == 7);
+	}
+
+	SECTION("Sorting pools")
+	{
+		struct SortTestData
+		{
+			int Value;
+		};
+
+		for (int i{}; i < 100; ++i)
+		{
+			const ECS::Entity entity{ registry.CreateEntity() };
+
+			registry.AddComponent<SortTestData>(entity, (i * 37) % 100);
+
+			if (i % 3 != 0)
+			{
+				registry.AddComponent<GravityComponent>(entity, static_cast<float>(i));
+			}
+		}
+
+		registry.Sort<SortTestData>([](const SortTestData& lhs, const SortTestData& rhs)->bool
+			{
+				return lhs.Value < rhs.Value;
+			});
+
+		int previous{ -1 };
+		bool isSorted{ true };
+
+		registry.CreateView<const SortTestData>().ForEach([&previous, &isSorted](const SortTestData& data)->void
+			{
+				isSorted &= previous < data.Value;
+				previous = data.Value;
+			});
+
+		REQUIRE(isSorted);
+
+		for (ECS::Entity entity{}; entity < 100; ++entity)
+		{
+			if (registry.GetComponent<SortTestData>(entity).Value != (static_cast<int>(entity) * 37) % 100)
+			{
+				FAIL("Sorting separated a component from its entity");
+			}
+		}
+
+		/* Lined up with the gravity pool, the shared entities become a single contiguous run */
+		registry.Sort<SortTestData, GravityComponent>();
+
+		size_t nrOfChunks{};
+
+		registry.CreateView<const GravityComponent, const SortTestData>().ForEachChunk([&nrOfChunks](std::span<const GravityComponent> gravities, std::span<const SortTestData> data)->void
+			{
+				for (size_t i{}; i < data.size(); ++i)
+				{
+					REQUIRE(data[i].Value == (static_cast<int>(gravities[i].Gravity) * 37) % 100);
+				}
+
+				++nrOfChunks;
+			});
+
+		REQUIRE(nrOfChunks == 1);
+	}
+
+	SECTION("Owning groups keep their pools co-sorted")
+	{
+		struct GroupTestData
+		{
+			ECS::Entity Owner;
+		};
+
+		std::vector<ECS::Entity> entities{};
+
+		for (int i{}; i < 20; ++i)
+		{
+			ECS::Entity entity{ registry.CreateEntity() };
+
+			registry.AddComponent<GroupTestData>(entity, entity);
+
+			if (i % 2 == 0)
+			{
+				registry.AddComponent<GravityComponent>(entity);
+			}
+
+			entities.push_back(entity);
+		}
+
+		auto& group = registry.CreateGroup<GravityComponent, const GroupTestData>();
+
+		REQUIRE(&group == &registry.CreateGroup<GravityComponent, const GroupTestData>());
+		REQUIRE(group.Size() == 10);
+
+		registry.AddComponent<GravityComponent>(entities[1]);
+		registry.RemoveComponent<GravityComponent>(entities[0]);
+		registry.ReleaseEntity(entities[2]);
+
+		REQUIRE(group.Size() == 9);
+		REQUIRE(group.Contains(entities[1]));
+		REQUIRE(!group.Contains(entities[0]));
+
+		const ECS::Tick lastRun{ registry.AdvanceTick() };
+		size_t counter{};
+
+		group.ForEach([&registry, &counter](GravityComponent& gravity, const GroupTestData& data)->void
+			{
+				REQUIRE(&std::as_const(registry).GetComponent<GravityComponent>(data.Owner) == &gravity);
+				++counter;
 			});
+
+		REQUIRE(counter == 9);
+
+		size_t chunkSize{};
+
+		group.ForEachChunk([&chunkSize](std::span<GravityComponent> gravities, std::span<const GroupTestData> data)->void
+			{
+				REQUIRE(gravities.size() == data.size());
+				chunkSize = gravities.size();
+			});
+
+		REQUIRE(chunkSize == 9);
+
+		/* Only the elements the group hands out mutably are stamped */
+		size_t nrOfChangedData{};
+		size_t nrOfChangedGravities{};
+
+		registry.CreateView<const GroupTestData, ECS::Changed<GroupTestData>>(lastRun).ForEach([&nrOfChangedData](const GroupTestData&)->void
+			{
+				++nrOfChangedData;
+			});
+		registry.CreateView<const GravityComponent, ECS::Changed<GravityComponent>>(lastRun).ForEach([&nrOfChangedGravities](const GravityComponent&)->void
+			{
+				++nrOfChangedGravities;
+			});
+
+		REQUIRE(nrOfChangedData == 0);
+		REQUIRE(nrOfChangedGravities == 9);
+	}
+
+	SECTION("Chunked views hand out contiguous runs of matching entities")
+	{
+		struct ChunkTestData
+		{
+			ECS::Entity Owner;
+		};
+
+		for (int i{}; i < 100; ++i)
+		{
+			ECS::Entity entity{ registry.CreateEntity() };
+
+			registry.AddComponent<GravityComponent>(entity);
+			registry.AddComponent<ChunkTestData>(entity, entity);
+		}
+
+		size_t nrOfChunks{};
+		size_t nrOfEntities{};
+
+		const auto countChunk([&registry, &nrOfChunks, &nrOfEntities](std::span<const GravityComponent> gravities, std::span<ChunkTestData> data)->void
+			{
+				REQUIRE(gravities.size() == data.size());
+
+				for (size_t i{}; i < data.size(); ++i)
+				{
+					REQUIRE(&registry.GetComponent<GravityComponent>(data[i].Owner) == &gravities[i]);
+				}
+
+				++nrOfChunks;
+				nrOfEntities += data.size();
+			});
+
+		registry.CreateView<const GravityComponent, ChunkTestData>().ForEachChunk(countChunk);
+
+		REQUIRE(nrOfChunks == 1);
+		REQUIRE(nrOfEntities == 100);
+
+		/* Entity 10 is now only in the gravity pool and the last entity took its place there, which splits the run */
+		registry.RemoveComponent<ChunkTestData>(10);
+
+		nrOfChunks = 0;
+		nrOfEntities = 0;
+
+		registry.CreateView<const GravityComponent, ChunkTestData>().ForEachChunk(countChunk);
+
+		REQUIRE(nrOfChunks > 1);
+		REQUIRE(nrOfEntities == 99);
+
+		float totalGravity{};
+
+		registry.CreateView<GravityComponent>().ForEachChunk([&totalGravity](std::span<GravityComponent> gravities)->void
+			{
+				for (const GravityComponent& gravity : gravities)
+				{
+					totalGravity += gravity.Gravity;
+				}
+			});
+
+		REQUIRE(totalGravity == 100 * GravityComponent{}.Gravity);
+	}
+
+	SECTION("Cached groups track their matching entities")
+	{
+		struct CachedGroupTestData
+		{
+			int Value;
+		};
+
+		std::vector<ECS::Entity> entities{};
+
+		for (int i{}; i < 10; ++i)
+		{
+			ECS::Entity entity{ registry.CreateEntity() };
+
+			registry.AddComponent<CachedGroupTestData>(entity, i);
+
+			if (i < 5)
+			{
+				registry.AddComponent<GravityComponent>(entity);
+			}
+
+			entities.push_back(entity);
+		}
+
+		auto& group = registry.CreateCachedGroup<const GravityComponent, const CachedGroupTestData>();
+		auto& owningGroup = registry.CreateGroup<GravityComponent, TransformComponent>();
+
+		REQUIRE(group.Size() == 5);
+
+		registry.AddComponent<GravityComponent>(entities[7]);
+		registry.AddComponent<TransformComponent>(entities[7]);
+		registry.RemoveComponent<CachedGroupTestData>(entities[0]);
+		registry.ReleaseEntity(entities[1]);
+
+		REQUIRE(group.Size() == 4);
+		REQUIRE(owningGroup.Size() == 1);
+		REQUIRE(group.Contains(entities[7]));
+		REQUIRE(!group.Contains(entities[0]));
+		REQUIRE(!group.Contains(entities[1]));
+
+		int sum{};
+
+		group.ForEach([&sum](const GravityComponent&, const CachedGroupTestData& data)->void
+			{
+				sum += data.Value;
+			});
+
+		REQUIRE(sum == 2 + 3 + 4 + 7);
+	}
+
+	SECTION("Parallel views visit every entity once")
+	{
+		ECS::ThreadPool threadPool{ 3 };
+		registry.SetThreadPool(&threadPool);
+
+		constexpr int size{ 10'000 };
+
+		for (int i{}; i < size; ++i)
+		{
+			ECS::Entity entity{ registry.CreateEntity() };
+
+			registry.AddComponent<GravityComponent>(entity);
+			registry.AddComponent<RigidBodyComponent>(entity);
+		}
+
+		auto view = registry.CreateView<GravityComponent, RigidBodyComponent>();
+
+		std::atomic<int> counter{};
+
+		view.ForEachParallel([&counter](const GravityComponent& gravity, RigidBodyComponent& rigidBody)->void
+			{
+				rigidBody.Velocity.y += gravity.Gravity;
+				++counter;
+			}, 64);
+
+		REQUIRE(counter == size);
+
+		int nrOfUpdatedEntities{};
+
+		view.ForEach([&nrOfUpdatedEntities](const GravityComponent& gravity, const RigidBodyComponent& rigidBody)->void
+			{
+				if (rigidBody.Velocity.y == gravity.Gravity) ++nrOfUpdatedEntities;
+			});
+
+		REQUIRE(nrOfUpdatedEntities == size);
+	}
+
+	SECTION("Scheduled systems keep the order of conflicting accesses")
+	{
+		struct ScheduledTestData
+		{
+			int Value;
+		};
+
+		ECS::ThreadPool threadPool{ 3 };
+		registry.SetThreadPool(&threadPool);
+
+		constexpr int size{ 1'000 };
+
+		for (int i{}; i < size; ++i)
+		{
+			ECS::Entity entity{ registry.CreateEntity() };
+
+			registry.AddComponent<GravityComponent>(entity);
+			registry.AddComponent<RigidBodyComponent>(entity).Mass = 1.f;
+			registry.AddComponent<TransformComponent>(entity).Position = Point2f{};
+			registry.AddComponent<ScheduledTestData>(entity, i);
+		}
+
+		ECS::SystemScheduler scheduler{ registry };
+
+		scheduler.AddSystem<const GravityComponent, RigidBodyComponent>([](const GravityComponent& gravity, RigidBodyComponent& rigidBody)->void
+			{
+				rigidBody.Velocity.y += gravity.Gravity * rigidBody.Mass;
+			});
+		scheduler.AddSystem<const RigidBodyComponent, TransformComponent>([](const RigidBodyComponent& rigidBody, TransformComponent& transform)->void
+			{
+				transform.Position.y += rigidBody.Velocity.y;
+			});
+		struct SkippedTag {};
+
+		scheduler.AddSystem<ScheduledTestData, ECS::Exclude<SkippedTag>, ECS::Maybe<const GravityComponent>>([](ScheduledTestData& data, const GravityComponent* pGravity)->void
+			{
+				if (pGravity) ++data.Value;
+			});
+
+		for (int i{}; i < 2; ++i)
+		{
+			scheduler.Update();
+		}
+
+		int nrOfCorrectEntities{};
+
+		registry.CreateView<const TransformComponent, const ScheduledTestData>().ForEach([&nrOfCorrectEntities](const TransformComponent& transform, const ScheduledTestData&)->void
+			{
+				/* The physics system has to see the velocity of the gravity system of the same frame */
+				if (transform.Position.y == -981.f * 3.f) ++nrOfCorrectEntities;
+			});
+
+		REQUIRE(nrOfCorrectEntities == size);
+		REQUIRE(registry.GetComponent<ScheduledTestData>(0).Value == 2);
+	}
+
+	SECTION("Removing Entities")
+	{
+		struct RemoveEntityTestData
+		{
+			std::string Name;
+		};
+
+		for (int i{}; i < 5; ++i)
+		{
+			ECS::Entity entity{ registry.CreateEntity() };
+
+			registry.AddComponent<RemoveEntityTestData>(entity, std::to_string(i));
+		}
+
+		registry.ReleaseEntity(3);
+
+		REQUIRE(registry.GetAmountOfEntities() == 4);
+		REQUIRE(registry.GetComponent<RemoveEntityTestData>(2).Name == "2");
+		REQUIRE(registry.GetComponent<RemoveEntityTestData>(4).Name == "4");
+	}
+
+	SECTION("Releasing entities in a batch")
+	{
+		struct BatchReleaseTestData
+		{
+			int Value;
+		};
+		struct BatchReleaseTag {};
+
+		std::vector<ECS::Entity> entities(10);
+		registry.CreateEntities<BatchReleaseTestData>(entities.size(), entities.begin());
+
+		for (size_t i{}; i < entities.size(); ++i)
+		{
+			registry.GetComponent<BatchReleaseTestData>(entities[i]).Value = static_cast<int>(i);
+
+			if (i % 2 == 0)
+			{
+				registry.AddComponent<BatchReleaseTag>(entities[i]);
+			}
+		}
+
+		/* Releasing an entity twice or releasing a stale one does nothing */
+		const std::vector<ECS::Entity> released{ entities[0], entities[3], entities[4], entities[3] };
+
+		REQUIRE(registry.ReleaseEntities(released) == 3);
+		REQUIRE(registry.ReleaseEntities(released) == 0);
+		REQUIRE(registry.GetAmountOfEntities() == 7);
+
+		size_t nrOfTagged{};
+
+		registry.CreateView<const BatchReleaseTestData>().ForEach([&nrOfTagged](const BatchReleaseTestData& data)->void
+			{
+				REQUIRE(data.Value != 0);
+				REQUIRE(data.Value != 3);
+				REQUIRE(data.Value != 4);
+
+				if (data.Value % 2 == 0) ++nrOfTagged;
+			});
+
+		REQUIRE(nrOfTagged == 3);
+
+		size_t nrOfTags{};
+
+		registry.CreateView<const BatchReleaseTag>().ForEach([&nrOfTags](const BatchReleaseTag&)->void
+			{
+				++nrOfTags;
+			});
+
+		REQUIRE(nrOfTags == 3);
+	}
+
+	SECTION("Creating many entities")
+	{
+		struct EntityTest final
+		{
+			std::string Name;
+		};
+
+#pragma warning ( push )
+#pragma warning ( disable:4834 )
+		for (size_t i{}; i < 10; ++i) registry.CreateEntity();
+#pragma warning ( pop )
+
+		ECS::Entity entity{ registry.CreateEntity() };
+
+		registry.AddComponent<EntityTest>(entity, "Entity");
+
+		auto view = registry.CreateView<EntityTest>();
+
+		view.ForEach([](const auto& test)->void
+			{
+				REQUIRE(test.Name == "Entity");
+			});
+	}
+}
+
+TEST_CASE("Testing archetype ECS")
+{
+	ECS::ArchetypeRegistry registry{};
+
+	REQUIRE(registry.GetAmountOfEntities() == 0);
+
+	SECTION("Making 10 entities and testing their updates")
+	{
+		constexpr int size{ 10 };
+
+		float startPositions[size]{};
+		ECS::Entity entities[size]{};
+
+		for (int i{}; i < size; ++i)
+		{
+			ECS::Entity entity{ registry.CreateEntity() };
+
+			registry.AddComponent<GravityComponent>(entity);
+			registry.AddComponent<TransformComponent>(entity);
+
+			if (i % 2 == 0)
+			{
+				registry.AddComponent<RigidBodyComponent>(entity);
+			}
+
+			startPositions[i] = registry.GetComponent<TransformComponent>(entity).Position.y;
+			entities[i] = entity;
+		}
+
+		REQUIRE(registry.GetAmountOfEntities() == size);
+
+		auto view = registry.CreateView<const GravityComponent, TransformComponent>();
+
+		REQUIRE(view.Size() == size);
+
+		view.ForEach([](const GravityComponent& grav, TransformComponent& trans)->void
+			{
+				trans.Position.y += grav.Gravity;
+			});
+
+		for (int i{}; i < size; ++i)
+		{
+			REQUIRE(registry.GetComponent<TransformComponent>(entities[i]).Position.y == startPositions[i] + GravityComponent{}.Gravity);
+			REQUIRE(registry.HasComponent<RigidBodyComponent>(entities[i]) == (i % 2 == 0));
+		}
+
+		REQUIRE(registry.CreateView<RigidBodyComponent, TransformComponent>().Size() == size / 2);
+	}
+
+	SECTION("Removing components and entities moves the remaining ones")
+	{
+		struct ArchetypeTestData
+		{
+			std::string Name;
+		};
+
+		std::vector<ECS::Entity> entities{};
+
+		for (int i{}; i < 5'000; ++i)
+		{
+			ECS::Entity entity{ registry.CreateEntity() };
+
+			registry.AddComponent<ArchetypeTestData>(entity, std::to_string(i));
+			registry.AddComponent<GravityComponent>(entity);
+
+			entities.push_back(entity);
+		}
+
+		registry.RemoveComponent<GravityComponent>(entities[10]);
+		registry.ReleaseEntity(entities[20]);
+
+		REQUIRE(registry.GetAmountOfEntities() == 4'999);
+		REQUIRE(!registry.HasEntity(entities[20]));
+		REQUIRE(!registry.HasComponent<GravityComponent>(entities[10]));
+		REQUIRE(registry.CreateView<GravityComponent>().Size() == 4'998);
+
+		for (int i{}; i < 5'000; ++i)
+		{
+			if (i != 20 && registry.GetComponent<ArchetypeTestData>(entities[i]).Name != std::to_string(i))
+			{
+				FAIL("Component does not belong to its entity anymore");
+			}
+		}
+	}
+
+	SECTION("A component that fails to construct leaves the entity as it was")
+	{
+		struct ThrowingTestData
+		{
+			explicit ThrowingTestData(const bool shouldThrow)
+			{
+				if (shouldThrow)
+				{
+					throw std::runtime_error{ "ThrowingTestData" };
+				}
+			}
+		};
+
+		const ECS::Entity entity{ registry.CreateEntity() };
+
+		registry.AddComponent<TransformComponent>(entity);
+		registry.GetComponent<TransformComponent>(entity).Position.y = 5.f;
+
+		REQUIRE_THROWS(registry.AddComponent<ThrowingTestData>(entity, true));
+		REQUIRE(!registry.HasComponent<ThrowingTestData>(entity));
+		REQUIRE(registry.GetComponent<TransformComponent>(entity).Position.y == 5.f);
+
+		registry.AddComponent<ThrowingTestData>(entity, false);
+
+		REQUIRE(registry.HasComponent<ThrowingTestData>(entity));
+		REQUIRE(registry.CreateView<ThrowingTestData, TransformComponent>().Size() == 1);
 	}
 }
\ No newline at end of file
@@ -0,0 +1,98 @@
+#pragma once
+
+#include "../ECSConstants.h"
+
+#include <assert.h> /* assert() */
+#include <memory_resource> /* std::pmr::memory_resource, std::pmr::vector, std::pmr::polymorphic_allocator */
+#include <utility> /* std::move() */
+
+namespace ECS
+{
+	/* The table of fixed-size pages of PageSize Ts behind PagedSparseArray and PagedComponentStorage.
+	   Pages are allocated from pResource and can only be handed back to it, so a page can be null until it is needed
+	   and the pages of another list can only be taken over when both allocate from equal resources, see TakePages().
+	   The list only manages memory, constructing and destroying what is in the pages is up to its owner */
+	template<typename T, size_t PageSize>
+	class PageList final
+	{
+	public:
+		explicit PageList(std::pmr::memory_resource* const pResource = std::pmr::get_default_resource())
+			: m_Pages{ pResource }
+		{}
+		~PageList()
+		{
+			ReleasePages(0);
+		}
+
+		PageList(const PageList&) noexcept = delete;
+		PageList(PageList&& other) noexcept
+			: m_Pages{ std::move(other.m_Pages) }
+		{
+			other.m_Pages.clear();
+		}
+		PageList& operator=(const PageList&) noexcept = delete;
+		PageList& operator=(PageList&&) noexcept = delete;
+
+		/* Releases the pages of this list and takes over the ones of other if both allocate from equal resources.
+		   Returns false when they do not, the owner then has to copy the contents of other over itself */
+		[[nodiscard]] bool TakePages(PageList& other)
+		{
+			ReleasePages(0);
+
+			if (!GetResource()->is_equal(*other.GetResource()))
+			{
+				return false;
+			}
+
+			m_Pages.swap(other.m_Pages);
+			return true;
+		}
+
+		/* Allocates page, growing the table when needed. The page must not exist yet */
+		T* AllocatePage(const size_t page)
+		{
+			if (m_Pages.size() <= page)
+			{
+				m_Pages.resize(page + 1);
+			}
+
+			assert(!m_Pages[page]);
+
+			m_Pages[page] = GetAllocator().allocate(PageSize);
+			return m_Pages[page];
+		}
+
+		/* Releases page and leaves a null page in its place */
+		void ReleasePage(const size_t page)
+		{
+			if (m_Pages[page])
+			{
+				GetAllocator().deallocate(m_Pages[page], PageSize);
+				m_Pages[page] = nullptr;
+			}
+		}
+
+		/* Releases every page from firstPage on and shrinks the table to firstPage */
+		void ReleasePages(const size_t firstPage)
+		{
+			while (m_Pages.size() > firstPage)
+			{
+				ReleasePage(m_Pages.size() - 1);
+				m_Pages.pop_back();
+			}
+		}
+
+		void Reserve(const size_t nrOfPages) { m_Pages.reserve(nrOfPages); }
+		void ShrinkToFit() { m_Pages.shrink_to_fit(); }
+
+		[[nodiscard]] size_t Size() const { return m_Pages.size(); }
+		[[nodiscard]] T* operator[](const size_t page) const { return m_Pages[page]; }
+
+		[[nodiscard]] std::pmr::memory_resource* GetResource() const { return m_Pages.get_allocator().resource(); }
+
+	private:
+		[[nodiscard]] std::pmr::polymorphic_allocator<T> GetAllocator() const { return std::pmr::polymorphic_allocator<T>{ GetResource() }; }
+
+		std::pmr::vector<T*> m_Pages;
+	};
+}
\ No newline at end of file
@@ -1,50 +1,326 @@
 #pragma once
 
 #include "../ComponentArray/ComponentArray.h"
-#include "../SparseSet/SparseSet.h"
+#include "../SparseSet/DenseSet.h"
+#include "../ThreadPool/ThreadPool.h"
+#include "ViewFilters.h"
 
-#include <functional> /* std::function, std::reference_wrapper */
+#include "../ECSConstants.h"
+#include "../ComponentIDGenerator/ComponentIDGenerator.h"
+
+#include <array> /* std::array */
+#include <assert.h> /* assert() */
+#include <memory_resource> /* std::pmr::vector */
+#include <span> /* std::span */
+#include <tuple> /* std::tuple, std::apply() */
+#include <type_traits> /* std::type_identity, std::remove_pointer_t */
 #include <utility> /* std::move(), ... */
 #include <vector> /* std::vector */
 
 namespace ECS
 {
+	/* The indices of the elements of a View that are handed to the function, so every element except for Exclude */
+	template<typename ... Ts>
+	struct ViewArguments final
+	{
+		static constexpr std::array<bool, sizeof ... (Ts)> IsArgument{ ViewElementTraits<Ts>::IsArgument... };
+		static constexpr size_t Count{ (size_t(ViewElementTraits<Ts>::IsArgument) + ...) };
+
+		static constexpr std::array<size_t, Count> Indices{ []()
+			{
+				std::array<size_t, Count> indices{};
+
+				for (size_t i{}, argument{}; i < IsArgument.size(); ++i)
+				{
+					if (IsArgument[i])
+					{
+						indices[argument++] = i;
+					}
+				}
+
+				return indices;
+			}() };
+
+		template<size_t ... As>
+		static std::index_sequence<Indices[As]...> MakeIndexSequence(const std::index_sequence<As...>&);
+
+		using IndexSequence = decltype(MakeIndexSequence(std::make_index_sequence<Count>{}));
+	};
+
+	/* Every entity that has all of the plain Ts, Ts may also contain Maybe<T>, Exclude<Ts...>, Changed<T> and Added<T> filters, see ViewFilters.h.
+	   A const T only hands out const T&, a T with its own StorageType hands out that storage's reference type instead.
+	   Handing out a T that is not const stamps it as modified at the current tick of its pool */
 	template<typename ... Ts>
 	class View final
 	{
-		using ViewContainerType = std::tuple<ComponentArray<Ts>&...>;
+		using ViewContainerType = std::tuple<typename ViewElementTraits<Ts>::Pool...>;
+
+		static_assert((ViewElementTraits<Ts>::IsRequired || ...), "A View needs at least one component that is not a filter");
 
 	public:
 		View() = default;
-		View(ViewContainerType&& components, const SparseSet<Entity>& entities)
-			: m_Components{ std::move(components) }
-			, Entities{ entities }
-		{}
+
+		/* findPool(std::type_identity<T>{}) returns the ComponentArray<T>* of the Registry, or nullptr if it does not exist.
+		   Only Maybe and Exclude may refer to pools that do not exist.
+		   signatures holds the EntitySignature of every entity, indexed by entity index.
+		   Changed and Added filters only let through components with a tick after sinceTick */
+		template<typename FindPool>
+		View(const FindPool& findPool, const std::pmr::vector<EntitySignature>& signatures, const Tick sinceTick, ThreadPool& threadPool)
+			: m_Components{ FindElementPool<Ts>(findPool)... }
+			, m_pSignatures{ &signatures }
+			, m_RequiredSignature{}
+			, m_ExcludedSignature{}
+			, m_SinceTick{ sinceTick }
+			, m_pThreadPool{ &threadPool }
+			, m_pDrivingEntities{}
+			, m_DrivingPool{}
+		{
+			(AddToSignatures<Ts>(), ...);
+
+			SelectDrivingPool(std::make_index_sequence<sizeof ... (Ts)>{});
+		}
 
 		View(const View&) noexcept = delete;
 		View& operator=(const View&) noexcept = delete;
 
-		void ForEach(const std::function<void(Ts&...)>& function) const
+		/* Function is called as function(ComponentReference<Ts>...) and is taken as a template so it can be fully inlined.
+		   Every component that is not const is stamped as modified. Maybe<T> is handed out as a T* and Exclude is left out.
+		   Iterates back to front, so the current entity can safely be removed from inside the function */
+		template<typename Function>
+		void ForEach(Function&& function) const
 		{
-			auto indexSequence{ std::make_index_sequence<sizeof ... (Ts)>{} };
+			ForEachImpl(function, 0, m_pDrivingEntities->Size(), ArgumentIndices{});
+		}
+
+		/* Splits the driving pool into chunks of grainSize entities and runs them on the Registry's ThreadPool.
+		   Function is called concurrently for different entities, so it may freely write to the components it is handed,
+		   but it must not add or remove components or entities */
+		template<typename Function>
+		void ForEachParallel(Function&& function, const size_t grainSize = DefaultGrainSize) const
+		{
+			m_pThreadPool->ParallelFor(m_pDrivingEntities->Size(), grainSize, [this, &function](const size_t begin, const size_t end)->void
+				{
+					ForEachImpl(function, begin, end, ArgumentIndices{});
+				});
+		}
 
-			for (const Entity entity : Entities)
+		/* Function is called as function(std::span<Ts>...) for every run of matching entities whose components are contiguous
+		   and in the same order in every pool, so the function can work on whole arrays at once.
+		   A single-component view is one run, a multi-component view gets runs as long as its pools are lined up,
+		   which is the case for pools owned by the same Group or pools sorted in the same order.
+		   Only supported without filters. Components must not be added or removed from inside the function */
+		template<typename Function>
+		void ForEachChunk(Function&& function) const
+		{
+			static_assert(((ViewElementTraits<Ts>::IsRequired && ViewElementTraits<Ts>::IsArgument) && ...), "View::ForEachChunk() does not support filters");
+
+			if constexpr (sizeof ... (Ts) == 1)
+			{
+				MarkModified<0>(0, std::get<0>(m_Components)->Size());
+
+				function(std::span<Ts...>{ std::get<0>(m_Components)->GetComponents() });
+			}
+			else
 			{
-				ForEachImpl(function, entity, indexSequence);
+				ForEachChunkImpl(function, std::make_index_sequence<sizeof ... (Ts)>{});
 			}
 		}
 
+		static constexpr size_t DefaultGrainSize{ 4096 };
+
 	private:
+		using ArgumentIndices = typename ViewArguments<Ts...>::IndexSequence;
+
+		template<typename T, typename FindPool>
+		[[nodiscard]] static typename ViewElementTraits<T>::Pool FindElementPool(const FindPool& findPool)
+		{
+			if constexpr (ViewElementTraits<T>::IsArgument || ViewElementTraits<T>::IsRequired)
+			{
+				const auto pPool{ findPool(std::type_identity<typename ViewElementTraits<T>::Component>{}) };
+
+				assert((!ViewElementTraits<T>::IsRequired || pPool) && "View::View() > A required component has no pool");
+
+				return pPool;
+			}
+			else
+			{
+				return {};
+			}
+		}
+
+		template<typename T>
+		void AddToSignatures()
+		{
+			if constexpr (ViewElementTraits<T>::IsRequired)
+			{
+				m_RequiredSignature.set(GenerateComponentID<typename ViewElementTraits<T>::Component>());
+			}
+			else if constexpr (!ViewElementTraits<T>::IsArgument)
+			{
+				AddToExcludedSignature(std::type_identity<T>{});
+			}
+		}
+		template<typename ... Es>
+		void AddToExcludedSignature(const std::type_identity<Exclude<Es...>>&)
+		{
+			(m_ExcludedSignature.set(GenerateComponentID<Es>()), ...);
+		}
+
+		/* The required pool with the fewest entities drives the iteration, the others are only probed */
+		template<size_t ... Is>
+		void SelectDrivingPool(const std::index_sequence<Is...>&)
+		{
+			(ConsiderDrivingPool<Is>(), ...);
+		}
+		template<size_t I>
+		void ConsiderDrivingPool()
+		{
+			if constexpr (ViewElementTraits<std::tuple_element_t<I, std::tuple<Ts...>>>::IsRequired)
+			{
+				const auto pPool{ std::get<I>(m_Components) };
+
+				if (!m_pDrivingEntities || pPool->Size() < m_pDrivingEntities->Size())
+				{
+					m_pDrivingEntities = &pPool->GetEntities();
+					m_DrivingPool = I;
+				}
+			}
+		}
+
+		template<typename Function, size_t ... As>
+		__forceinline void ForEachImpl(Function& function, const size_t begin, const size_t end, const std::index_sequence<As...>&) const
+		{
+			for (size_t i{ end }; i > begin; --i)
+			{
+				const Entity ent{ m_pDrivingEntities->GetFirstAt(i - 1) };
+
+				if ((!NeedsMatching || Matches(ent)) && (!HasTickFilters || MatchesTicks(ent, i - 1, std::make_index_sequence<sizeof ... (Ts)>{})))
+				{
+					function(GetComponent<As>(ent, i - 1)...);
+				}
+			}
+		}
+
+		template<typename Function, size_t ... Is>
+		void ForEachChunkImpl(Function& function, const std::index_sequence<Is...>&) const
+		{
+			const size_t size{ m_pDrivingEntities->Size() };
+
+			for (size_t i{}; i < size;)
+			{
+				const Entity ent{ m_pDrivingEntities->GetFirstAt(i) };
+
+				if (NeedsMatching && !Matches(ent))
+				{
+					++i;
+					continue;
+				}
+
+				const std::array<size_t, sizeof ... (Ts)> starts{ (Is == m_DrivingPool ? i : std::get<Is>(m_Components)->GetIndex(ent))... };
+
+				/* Grow the run for as long as the next entity follows directly after the previous one in every pool */
+				size_t length{ 1 };
+				for (; i + length < size; ++length)
+				{
+					const Entity next{ m_pDrivingEntities->GetFirstAt(i + length) };
+
+					if (!((Is == m_DrivingPool || (std::get<Is>(m_Components)->HasEntity(next) && std::get<Is>(m_Components)->GetIndex(next) == starts[Is] + length)) && ...))
+					{
+						break;
+					}
+				}
+
+				(MarkModified<Is>(starts[Is], length), ...);
+
+				function(std::span<Ts>{ std::get<Is>(m_Components)->GetComponents().subspan(starts[Is], length) }...);
+
+				i += length;
+			}
+		}
+
+		/* Every entity of the driving pool has the driving component, so a single component without filters needs no check at all */
+		static constexpr bool NeedsMatching{ (size_t(ViewElementTraits<Ts>::IsRequired) + ...) > 1 || !(ViewElementTraits<Ts>::IsArgument && ...) };
+
+		/* The signature of every entity has the bits of its components set, so checking every required and excluded component
+		   is a single masked compare instead of a sparse lookup per pool */
+		[[nodiscard]] __forceinline bool Matches(const Entity ent) const
+		{
+			const EntitySignature& signature{ (*m_pSignatures)[GetEntityIndex(ent)] };
+
+			return (signature & m_RequiredSignature) == m_RequiredSignature && (signature & m_ExcludedSignature).none();
+		}
+
+		static constexpr bool HasTickFilters{ ((ViewElementTraits<Ts>::TickFilter != ViewTickFilter::None) || ...) };
+
+		/* Only called for entities that have every required component, so every tick filter has a slot to check */
 		template<size_t ... Is>
-		void ForEachImpl(const std::function<void(Ts&...)>& function, const Entity ent, const std::index_sequence<Is...>&) const
+		[[nodiscard]] __forceinline bool MatchesTicks(const Entity ent, const size_t drivingIndex, const std::index_sequence<Is...>&) const
+		{
+			return (MatchesTick<Is>(ent, drivingIndex) && ...);
+		}
+		template<size_t I>
+		[[nodiscard]] __forceinline bool MatchesTick(const Entity ent, const size_t drivingIndex) const
+		{
+			constexpr ViewTickFilter filter{ ViewElementTraits<std::tuple_element_t<I, std::tuple<Ts...>>>::TickFilter };
+
+			if constexpr (filter == ViewTickFilter::None)
+			{
+				return true;
+			}
+			else
+			{
+				const auto pPool{ std::get<I>(m_Components) };
+				const size_t index{ I == m_DrivingPool ? drivingIndex : pPool->GetIndex(ent) };
+
+				return IsNewerTick(filter == ViewTickFilter::Added ? pPool->GetAddedTickAt(index) : pPool->GetModifiedTickAt(index), m_SinceTick);
+			}
+		}
+
+		template<size_t I>
+		__forceinline void MarkModified(const size_t index, const size_t count) const
+		{
+			if constexpr (!ViewElementTraits<std::tuple_element_t<I, std::tuple<Ts...>>>::IsReadOnly)
+			{
+				std::get<I>(m_Components)->MarkModifiedAt(index, count);
+			}
+		}
+
+		/* The driving pool already knows where the component lives, only the other pools need a sparse lookup */
+		template<size_t I>
+		[[nodiscard]] __forceinline typename ViewElementTraits<std::tuple_element_t<I, std::tuple<Ts...>>>::Argument GetComponent(const Entity ent, const size_t drivingIndex) const
 		{
-			if ((ent != InvalidEntityID) && (std::get<Is>(m_Components).HasEntity(ent) && ...))
+			using Traits = ViewElementTraits<std::tuple_element_t<I, std::tuple<Ts...>>>;
+
+			const auto pPool{ std::get<I>(m_Components) };
+
+			if constexpr (Traits::IsRequired && (Traits::IsReadOnly || std::remove_pointer_t<typename Traits::Pool>::IsTag))
+			{
+				return I == m_DrivingPool ? pPool->GetComponentAt(drivingIndex) : pPool->GetComponent(ent);
+			}
+			else if constexpr (Traits::IsRequired)
+			{
+				const size_t index{ I == m_DrivingPool ? drivingIndex : pPool->GetIndex(ent) };
+
+				pPool->MarkModifiedAt(index);
+				return pPool->GetComponentAt(index);
+			}
+			else if constexpr (Traits::IsReadOnly)
+			{
+				return pPool && pPool->HasEntity(ent) ? &pPool->GetComponent(ent) : nullptr;
+			}
+			else
 			{
-				std::apply(function, std::tuple<Ts&...>(std::get<Is>(m_Components).GetComponent(ent)...));
+				return pPool && pPool->HasEntity(ent) ? &pPool->ModifyComponent(ent) : nullptr;
 			}
 		}
 
 		ViewContainerType m_Components;
-		const SparseSet<Entity>& Entities;
+		const std::pmr::vector<EntitySignature>* m_pSignatures;
+		EntitySignature m_RequiredSignature;
+		EntitySignature m_ExcludedSignature;
+		Tick m_SinceTick;
+		ThreadPool* m_pThreadPool;
+		const DenseSet<Entity>* m_pDrivingEntities;
+		size_t m_DrivingPool;
 	};
 }
\ No newline at end of file
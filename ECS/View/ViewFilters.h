@@ -0,0 +1,99 @@
+#pragma once
+
+#include "../ComponentArray/ComponentArray.h"
+#include "../ComponentArray/ComponentStorage.h"
+
+#include <tuple> /* std::tuple */
+#include <type_traits> /* std::remove_const_t, std::is_reference_v, ... */
+
+namespace ECS
+{
+	/* View filter: only entities that have none of Ts are visited. Ts are not handed to the function */
+	template<typename ... Ts>
+	struct Exclude final {};
+
+	/* View filter: entities are visited whether they have T or not, the function gets a T* that is nullptr when they do not.
+	   A const T gives a const T* */
+	template<typename T>
+	struct Maybe final {};
+
+	/* View filter: only entities whose T was added or handed out mutably after the tick the View was created for are visited.
+	   The entity needs to have T, but T is not handed to the function */
+	template<typename T>
+	struct Changed final {};
+
+	/* View filter: only entities whose T was added after the tick the View was created for are visited.
+	   The entity needs to have T, but T is not handed to the function */
+	template<typename T>
+	struct Added final {};
+
+	/* Which tick of its component a View element compares against the tick the View was created for */
+	enum class ViewTickFilter
+	{
+		None,
+		Added,
+		Changed
+	};
+
+	/* How a single element of a View is stored and handed out */
+	template<typename T>
+	struct ViewElementTraits final
+	{
+		using Component = std::remove_const_t<T>;
+		using Pool = ComponentArray<Component>*;
+		using Argument = ComponentReference<T>;
+
+		static constexpr bool IsRequired{ true };
+		static constexpr bool IsArgument{ true };
+		static constexpr bool IsReadOnly{ std::is_const_v<T> };
+		static constexpr ViewTickFilter TickFilter{ ViewTickFilter::None };
+	};
+	template<typename T>
+	struct ViewElementTraits<Maybe<T>> final
+	{
+		static_assert(std::is_reference_v<ComponentReference<T>>, "Maybe<T> needs a storage that hands out real references");
+
+		using Component = std::remove_const_t<T>;
+		using Pool = ComponentArray<Component>*;
+		using Argument = std::remove_reference_t<ComponentReference<T>>*;
+
+		static constexpr bool IsRequired{ false };
+		static constexpr bool IsArgument{ true };
+		static constexpr bool IsReadOnly{ std::is_const_v<T> };
+		static constexpr ViewTickFilter TickFilter{ ViewTickFilter::None };
+	};
+	/* Tick filters only read the ticks of their pool, never the components */
+	template<typename T>
+	struct ViewElementTraits<Changed<T>> final
+	{
+		using Component = std::remove_const_t<T>;
+		using Pool = ComponentArray<Component>*;
+
+		static constexpr bool IsRequired{ true };
+		static constexpr bool IsArgument{ false };
+		static constexpr bool IsReadOnly{ true };
+		static constexpr ViewTickFilter TickFilter{ ViewTickFilter::Changed };
+	};
+	template<typename T>
+	struct ViewElementTraits<Added<T>> final
+	{
+		using Component = std::remove_const_t<T>;
+		using Pool = ComponentArray<Component>*;
+
+		static constexpr bool IsRequired{ true };
+		static constexpr bool IsArgument{ false };
+		static constexpr bool IsReadOnly{ true };
+		static constexpr ViewTickFilter TickFilter{ ViewTickFilter::Added };
+	};
+	/* Excluded components are only checked through the EntitySignature of the entity, so they need no pool */
+	template<typename ... Ts>
+	struct ViewElementTraits<Exclude<Ts...>> final
+	{
+		using Pool = std::tuple<>;
+
+		static constexpr bool IsRequired{ false };
+		static constexpr bool IsArgument{ false };
+		static constexpr bool IsReadOnly{ true };
+		static constexpr ViewTickFilter TickFilter{ ViewTickFilter::None };
+	};
+}